@@ -11,6 +11,31 @@
 ///Rozmiar alokacji pojedynczego segmentu stosu (w liczbie wielomianów)
 #define CS_HUNK_SIZE 254
 
+///Liczba rund probabilistycznego testu równości w operacji <c>OPERATION_IS_EQ_FAST</c>
+#define CS_IS_EQ_FAST_ROUNDS 4
+
+
+/**
+ * Pojedynczy element stosu: wielomian (zwykły albo zamrożony) wraz z leniwie wyliczanym skrótem.
+ */
+typedef struct
+{
+    union
+    {
+        ///Wielomian, gdy element nie jest zamrożony
+        Poly poly;
+
+        ///Wielomian zamrożony (PolyFreeze()), gdy element jest zamrożony
+        PolyFrozen frozen;
+    };
+
+    ///Skrót wielomianu (PolyHash()); 0 oznacza, że skrót nie został jeszcze wyliczony
+    uint64_t hash;
+
+    ///Czy element jest zamrożony
+    bool isFrozen;
+} CSStackEntry;
+
 
 /**
  * Struktura pojedynczego segmentu stosu.
@@ -24,7 +49,7 @@ struct CSStackHunk
     struct CSStackHunk *nextHunk;
 
     ///Dane tego segmentu stosu
-    Poly data[CS_HUNK_SIZE];
+    CSStackEntry data[CS_HUNK_SIZE];
 };
 
 
@@ -36,27 +61,116 @@ struct CSStackHunk
 static struct CSStackHunk *CSAllocHunk();
 
 /**
- * Dostęp do wskaźnika na wielomian znajdujący się na wierzchu stosu.
+ * Dostęp do wskaźnika na element znajdujący się na wierzchu stosu.
  * Jeżeli stos jest pusty, może zabić program assertem.
  * @param cs struktura stosu
+ * @return element na wierzchołku stosu
+ */
+static CSStackEntry *CSTopEntry(CalculatorStack *cs);
+
+/**
+ * Dostęp do wskaźnika na wielomian znajdujący się na wierzchu stosu (rozmraża go, jeśli był zamrożony).
+ * Jeżeli stos jest pusty, może zabić program assertem. Wywołujący, który zmienia wielomian, musi unieważnić jego
+ * skrót przez CSTopEntry().
+ * @param cs struktura stosu
  * @return wielomian na wierzchołku stosu
  */
 static Poly *CSTopPtr(CalculatorStack *cs);
 
 /**
- * Zdejmuje wielomian z wierzchołka stosu.
+ * Wpycha element (wielomian wraz ze skrótem) na stos. Przykryty element jest zamrażany, jeśli stos przechowuje
+ * elementy w postaci zamrożonej.
+ * @param cs struktura stosu
+ * @param entry element
+ */
+static void CSPushEntry(CalculatorStack *cs, CSStackEntry entry);
+
+/**
+ * Zdejmuje element z wierzchołka stosu.
+ * Próba wykonania na pustym stosie, może zabić assertem.
+ * @param cs struktura stosu
+ * @return element z wierzchołka stosu
+ */
+static CSStackEntry CSPopEntry(CalculatorStack *cs);
+
+/**
+ * Zwraca skrót wielomianu z elementu stosu, wyliczając go przy pierwszym użyciu.
+ * @param entry element stosu
+ * @return skrót wielomianu (niezerowy)
+ */
+static uint64_t CSEntryHash(CSStackEntry *entry);
+
+/**
+ * Zdejmuje wielomian z wierzchołka stosu (rozmrażając go, jeśli był zamrożony).
  * Próba wykonania na pustym stosie, może zabić assertem.
  * @param cs struktura stosu
  * @return wielomian z wierzchołka stosu
  */
 static Poly CSPopPolynomial(CalculatorStack *cs);
 
+/**
+ * Zamraża element stosu, jeśli stos przechowuje elementy w postaci zamrożonej, a element nie jest współczynnikiem
+ * ani nie ma dużych współczynników.
+ * @param cs stos kalkulatora
+ * @param entry element
+ */
+static void CSFreezeEntry(const CalculatorStack *cs, CSStackEntry *entry);
+
+/**
+ * Rozmraża element stosu, jeśli jest zamrożony.
+ * @param entry element
+ */
+static void CSThawEntry(CSStackEntry *entry);
+
+/**
+ * Zwraca nowe odwołanie do wielomianu z elementu stosu (kopię albo wielomian rozmrożony), nie zmieniając elementu.
+ * @param entry element
+ * @return wielomian do usunięcia przez wywołującego
+ */
+static Poly CSEntryPoly(const CSStackEntry *entry);
+
+/**
+ * Usuwa wielomian elementu stosu z pamięci.
+ * @param entry element
+ */
+static void CSEntryDestroy(CSStackEntry *entry);
+
 
 /**
- * Wykonuje operacje compose.
+ * Wykonuje operację mul z wykrywaniem przepełnienia (PolyMulChecked()).
  * @param cs stos kalkulatora
+ * @return <c>false</c>, gdy iloczyn nie mieści się w <c>poly_coeff_t</c>; stos nie jest wtedy zmieniany
  */
-static void CSExecuteCompose(CalculatorStack *cs);
+static bool CSExecuteMulChecked(CalculatorStack *cs);
+
+/**
+ * Wykonuje operacje compose (z wykrywaniem przepełnienia, gdy jest ono włączone).
+ * @param cs stos kalkulatora
+ * @return <c>false</c>, gdy złożenie nie mieści się w <c>poly_coeff_t</c>; stos nie jest wtedy zmieniany
+ */
+static bool CSExecuteCompose(CalculatorStack *cs);
+
+/**
+ * Wykonuje operację mod: ustawia moduł i redukuje wszystkie wielomiany na stosie.
+ * @param cs stos kalkulatora
+ */
+static void CSExecuteMod(CalculatorStack *cs);
+
+/**
+ * Wykonuje operację exact: przełącza dokładną arytmetykę współczynników, a przy jej wyłączaniu sprowadza wszystkie
+ * wielomiany na stosie do zakresu <c>poly_coeff_t</c>.
+ * @param cs stos kalkulatora
+ */
+static void CSExecuteExact(CalculatorStack *cs);
+
+/**
+ * Wykonuje operację na stosie (CSExecute()), nie korzystając z areny.
+ * @param cs stos kalkulatora
+ * @param op kod operacji
+ * @param out plik wyjściowy
+ * @return <c>false</c>, gdy wynik operacji nie mieści się w <c>poly_coeff_t</c>
+ */
+static bool CSExecuteOperation(CalculatorStack *cs, CSOperation op, FILE *out);
 
 
 
@@ -78,6 +192,9 @@ CalculatorStack CSInit()
     result.topHunk = result.bottomHunk;
     result.size = 0;
     result.topHunkTop = 0;
+    result.checked = false;
+    result.interned = false;
+    result.frozen = false;
 
     return result;
 }
@@ -88,17 +205,43 @@ void CSDestroy(CalculatorStack *cs)
     if (cs->bottomHunk == NULL)
         return;
     while (cs->size > 0) {
-        PolyDestroy(CSTopPtr(cs));
-        CSPopPolynomial(cs);
+        CSStackEntry entry = CSPopEntry(cs);
+        CSEntryDestroy(&entry);
     }
     free(cs->bottomHunk);
     cs->topHunk = cs->bottomHunk = NULL;
     cs->size = 0;
+    //Pamięć podręczna działań trzyma odwołania do wielomianów, które były na stosie
+    PolyCacheClear();
+}
+
+
+/**
+ * Zwraca wielomian internowany (PolyIntern()), jeśli stos internuje wielomiany; przejmuje argument na własność.
+ * @param cs stos
+ * @param poly wielomian
+ * @return wielomian równy <c>poly</c>
+ */
+static Poly CSInterned(CalculatorStack *cs, Poly poly)
+{
+    if (!cs->interned)
+        return poly;
+    Poly interned = PolyIntern(&poly);
+    PolyDestroy(&poly);
+    return interned;
 }
 
 
 void CSPushPolynomial(CalculatorStack *cs, Poly poly)
 {
+    CSPushEntry(cs, (CSStackEntry){.poly = CSInterned(cs, poly), .hash = 0});
+}
+
+
+static void CSPushEntry(CalculatorStack *cs, CSStackEntry entry)
+{
+    if (cs->size > 0)
+        CSFreezeEntry(cs, CSTopEntry(cs));
     if (cs->topHunkTop >= CS_HUNK_SIZE) {
         struct CSStackHunk *new_hunk = CSAllocHunk();
         cs->topHunk->nextHunk = new_hunk;
@@ -106,12 +249,20 @@ void CSPushPolynomial(CalculatorStack *cs, Poly poly)
         cs->topHunk = new_hunk;
         cs->topHunkTop = 0;
     }
-    cs->topHunk->data[cs->topHunkTop++] = poly;
+    cs->topHunk->data[cs->topHunkTop++] = entry;
     ++cs->size; //http://en.cppreference.com/w/c/language/operator_precedence :)
 }
 
 
 static Poly CSPopPolynomial(CalculatorStack *cs)
+{
+    CSStackEntry entry = CSPopEntry(cs);
+    CSThawEntry(&entry);
+    return entry.poly;
+}
+
+
+static CSStackEntry CSPopEntry(CalculatorStack *cs)
 {
     assert(cs->size > 0);
     if (cs->topHunkTop == 0) {
@@ -125,7 +276,7 @@ static Poly CSPopPolynomial(CalculatorStack *cs)
 }
 
 
-static Poly *CSTopPtr(CalculatorStack *cs)
+static CSStackEntry *CSTopEntry(CalculatorStack *cs)
 {
     assert(cs->size > 0);
     if (cs->topHunkTop != 0)
@@ -134,12 +285,102 @@ static Poly *CSTopPtr(CalculatorStack *cs)
 }
 
 
+static Poly *CSTopPtr(CalculatorStack *cs)
+{
+    CSStackEntry *entry = CSTopEntry(cs);
+    CSThawEntry(entry);
+    return &entry->poly;
+}
+
+
+static void CSFreezeEntry(const CalculatorStack *cs, CSStackEntry *entry)
+{
+    //Internowane wielomiany są już współdzielone; zamrożenie by je rozdzieliło
+    if (!cs->frozen || cs->interned || entry->isFrozen || PolyIsCoeff(&entry->poly))
+        return;
+    PolyFrozen frozen;
+    if (!PolyFreeze(&entry->poly, &frozen))
+        return;
+    PolyDestroy(&entry->poly);
+    if (PolyFrozenIsCoeff(&frozen)) {
+        entry->poly = PolyFromCoeff(frozen.coef);
+    } else {
+        entry->frozen = frozen;
+        entry->isFrozen = true;
+    }
+}
+
+
+static void CSThawEntry(CSStackEntry *entry)
+{
+    if (!entry->isFrozen)
+        return;
+    Poly poly = PolyThaw(&entry->frozen);
+    PolyFrozenDestroy(&entry->frozen);
+    entry->poly = poly;
+    entry->isFrozen = false;
+}
+
+
+static Poly CSEntryPoly(const CSStackEntry *entry)
+{
+    return entry->isFrozen ? PolyThaw(&entry->frozen) : PolyClone(&entry->poly);
+}
+
+
+static void CSEntryDestroy(CSStackEntry *entry)
+{
+    if (entry->isFrozen)
+        PolyFrozenDestroy(&entry->frozen);
+    else
+        PolyDestroy(&entry->poly);
+}
+
+
+/**
+ * Sprawdza, czy wielomiany z dwóch elementów stosu są równe; zamrożone elementy są porównywane bez rozmrażania.
+ * @param e1 element
+ * @param e2 element
+ * @return czy wielomiany są równe
+ */
+static bool CSEntriesEqual(CSStackEntry *e1, CSStackEntry *e2)
+{
+    if (CSEntryHash(e1) != CSEntryHash(e2))
+        return false;
+    if (e1->isFrozen && e2->isFrozen)
+        return PolyFrozenIsEq(&e1->frozen, &e2->frozen);
+    if (!e1->isFrozen && !e2->isFrozen)
+        return PolyIsEq(&e1->poly, &e2->poly);
+    Poly p1 = CSEntryPoly(e1), p2 = CSEntryPoly(e2);
+    bool equal = PolyIsEq(&p1, &p2);
+    PolyDestroy(&p1);
+    PolyDestroy(&p2);
+    return equal;
+}
+
+
+static uint64_t CSEntryHash(CSStackEntry *entry)
+{
+    if (entry->hash == 0) {
+        entry->hash = entry->isFrozen ? PolyFrozenHash(&entry->frozen) : PolyHash(&entry->poly);
+        entry->hash += entry->hash == 0;
+    }
+    return entry->hash;
+}
+
+
 bool CSCanExecute(CalculatorStack *cs, CSOperation op)
 {
     switch (op) {
         case OPERATION_INVALID:
             return false;
         case OPERATION_ZERO:
+        case OPERATION_MOD:
+        case OPERATION_EXACT:
+        case OPERATION_CHECKED:
+        case OPERATION_INTERN:
+        case OPERATION_CACHE_CLEAR:
+        case OPERATION_FREEZE:
             return true;
         case OPERATION_IS_COEFF:
         case OPERATION_IS_ZERO:
@@ -148,6 +389,8 @@ bool CSCanExecute(CalculatorStack *cs, CSOperation op)
         case OPERATION_DEG:
         case OPERATION_DEG_BY:
         case OPERATION_AT:
+        case OPERATION_SHIFT:
+        case OPERATION_POW:
         case OPERATION_PRINT:
         case OPERATION_POP:
             return cs->size > 0;
@@ -155,6 +398,7 @@ bool CSCanExecute(CalculatorStack *cs, CSOperation op)
         case OPERATION_MUL:
         case OPERATION_SUB:
         case OPERATION_IS_EQ:
+        case OPERATION_IS_EQ_FAST:
             return cs->size > 1;
         case OPERATION_COMPOSE:
             return cs->uiArg < UINT_MAX && cs->uiArg + 1 <= cs->size;
@@ -192,8 +436,26 @@ CSOperation CSOperationFromString(const char *op_name) {
         return OPERATION_SUB;
     if (strcmp(op_name, "IS_EQ") == 0)
         return OPERATION_IS_EQ;
+    if (strcmp(op_name, "IS_EQ_FAST") == 0)
+        return OPERATION_IS_EQ_FAST;
     if (strcmp(op_name, "COMPOSE") == 0)
         return OPERATION_COMPOSE;
+    if (strcmp(op_name, "SHIFT") == 0)
+        return OPERATION_SHIFT;
+    if (strcmp(op_name, "POW") == 0)
+        return OPERATION_POW;
+    if (strcmp(op_name, "MOD") == 0)
+        return OPERATION_MOD;
+    if (strcmp(op_name, "EXACT") == 0)
+        return OPERATION_EXACT;
+    if (strcmp(op_name, "CHECKED") == 0)
+        return OPERATION_CHECKED;
+    if (strcmp(op_name, "INTERN") == 0)
+        return OPERATION_INTERN;
+    if (strcmp(op_name, "CACHE_CLEAR") == 0)
+        return OPERATION_CACHE_CLEAR;
+    if (strcmp(op_name, "FREEZE") == 0)
+        return OPERATION_FREEZE;
     return OPERATION_INVALID;
 }
 
@@ -209,26 +471,123 @@ static void CSBinaryOperator(CalculatorStack *cs, Poly (*op)(const Poly *, const
 }
 
 
-static void CSExecuteCompose(CalculatorStack *cs)
+static bool CSExecuteMulChecked(CalculatorStack *cs)
 {
-    Poly *subs = malloc(cs->uiArg * sizeof(Poly));
-    assert(subs != 0);
-    Poly main_arg = CSPopPolynomial(cs);
-    for (unsigned int i = 0; i < cs->uiArg; ++i)
-        subs[i] = CSPopPolynomial(cs);
-
-    CSPushPolynomial(cs, PolyCompose(&main_arg, cs->uiArg, subs));
-
-    PolyDestroy(&main_arg);
-    for (unsigned int i = 0; i < cs->uiArg; ++i)
-        PolyDestroy(subs + i);
-    free(subs);
+    CSStackEntry rarg = CSPopEntry(cs);
+    CSStackEntry larg = CSPopEntry(cs);
+    Poly rpoly = CSEntryPoly(&rarg), lpoly = CSEntryPoly(&larg);
+    Poly result;
+    bool success = PolyMulChecked(&rpoly, &lpoly, &result);
+    PolyDestroy(&rpoly);
+    PolyDestroy(&lpoly);
+    if (!success) {
+        CSPushEntry(cs, larg);
+        CSPushEntry(cs, rarg);
+        return false;
+    }
+    CSPushPolynomial(cs, result);
+    CSEntryDestroy(&rarg);
+    CSEntryDestroy(&larg);
+    return true;
 }
 
 
-void CSExecute(CalculatorStack *cs, CSOperation op, FILE *out) {
+static bool CSExecuteCompose(CalculatorStack *cs)
+{
+    //Pierwszy element to składany wielomian, a kolejne to podstawienia
+    CSStackEntry *args = malloc((cs->uiArg + 1) * sizeof(CSStackEntry));
+    Poly *polys = malloc((cs->uiArg + 1) * sizeof(Poly));
+    assert(args != 0 && polys != 0);
+    for (unsigned int i = 0; i <= cs->uiArg; ++i) {
+        args[i] = CSPopEntry(cs);
+        polys[i] = CSEntryPoly(args + i);
+    }
+
+    Poly result;
+    bool success = true;
+    if (!cs->checked)
+        result = PolyCompose(polys, cs->uiArg, polys + 1);
+    else
+        success = PolyComposeChecked(polys, cs->uiArg, polys + 1, &result);
+    for (unsigned int i = 0; i <= cs->uiArg; ++i)
+        PolyDestroy(polys + i);
+
+    //Przy niepowodzeniu przywracamy pierwotne elementy, żeby nie zostawić na stosie wielomianów z areny
+    if (success) {
+        for (unsigned int i = 0; i <= cs->uiArg; ++i)
+            CSEntryDestroy(args + i);
+        CSPushPolynomial(cs, result);
+    } else {
+        for (unsigned int i = cs->uiArg + 1; i-- > 0;)
+            CSPushEntry(cs, args[i]);
+    }
+    free(polys);
+    free(args);
+    return success;
+}
+
+
+/**
+ * Zastępuje każdy wielomian na stosie wynikiem funkcji <c>op</c> (np. sprowadza je do bieżącej arytmetyki
+ * współczynników funkcją PolyReduce()).
+ * @param cs stos
+ * @param op funkcja
+ */
+static void CSApplyAll(CalculatorStack *cs, Poly (*op)(const Poly *))
+{
+    uint32_t remaining = cs->size;
+    for (struct CSStackHunk *hunk = cs->bottomHunk; remaining > 0; hunk = hunk->nextHunk) {
+        uint32_t count = remaining < CS_HUNK_SIZE ? remaining : CS_HUNK_SIZE;
+        for (uint32_t i = 0; i < count; ++i) {
+            CSThawEntry(hunk->data + i);
+            Poly result = op(&hunk->data[i].poly);
+            PolyDestroy(&hunk->data[i].poly);
+            hunk->data[i] = (CSStackEntry){.poly = CSInterned(cs, result), .hash = 0};
+            if (remaining > count || i + 1 < count)
+                CSFreezeEntry(cs, hunk->data + i);
+        }
+        remaining -= count;
+    }
+}
+
+
+static void CSExecuteMod(CalculatorStack *cs)
+{
+    PolySetModulus(cs->pcArg);
+    if (cs->pcArg != 0)
+        CSApplyAll(cs, PolyReduce);
+}
+
+
+static void CSExecuteExact(CalculatorStack *cs)
+{
+    PolySetExactCoefficients(cs->uiArg != 0);
+    if (cs->uiArg == 0)
+        CSApplyAll(cs, PolyReduce);
+}
+
+
+bool CSExecute(CalculatorStack *cs, CSOperation op, FILE *out)
+{
     assert(CSCanExecute(cs, op));
-    Poly p1, p2;
+#ifdef CALC_POLY_USE_ARENA
+    //Te operacje tworzą wiele tymczasowych wielomianów; trwałą pamięć dostaje tylko wynik odłożony na stos
+    if (op == OPERATION_MUL || op == OPERATION_COMPOSE || op == OPERATION_POW || op == OPERATION_SHIFT) {
+        PolyArenaBegin();
+        bool success = CSExecuteOperation(cs, op, out);
+        PolyArenaEnd(success ? CSTopPtr(cs) : NULL);
+        if (success)
+            CSTopEntry(cs)->poly = CSInterned(cs, CSTopEntry(cs)->poly);
+        return success;
+    }
+#endif
+    return CSExecuteOperation(cs, op, out);
+}
+
+
+static bool CSExecuteOperation(CalculatorStack *cs, CSOperation op, FILE *out) {
+    Poly p1;
+    CSStackEntry e1, e2;
 
     switch (op) {
         case OPERATION_INVALID:
@@ -237,38 +596,69 @@ void CSExecute(CalculatorStack *cs, CSOperation op, FILE *out) {
             CSPushPolynomial(cs, PolyZero());
             break;
         case OPERATION_IS_COEFF:
-            fprintf(out, "%i\n", (int)PolyIsCoeff(CSTopPtr(cs)));
+            e1 = *CSTopEntry(cs);
+            fprintf(out, "%i\n", (int)(e1.isFrozen ? PolyFrozenIsCoeff(&e1.frozen) : PolyIsCoeff(&e1.poly)));
             break;
         case OPERATION_IS_ZERO:
-            fprintf(out, "%i\n", (int)PolyIsZero(CSTopPtr(cs)));
+            e1 = *CSTopEntry(cs);
+            fprintf(out, "%i\n", (int)(e1.isFrozen ? PolyFrozenIsZero(&e1.frozen) : PolyIsZero(&e1.poly)));
             break;
         case OPERATION_CLONE:
-            CSPushPolynomial(cs, PolyClone(CSTopPtr(cs)));
+            e1 = *CSTopEntry(cs);
+            if (e1.isFrozen)
+                e1.frozen = PolyFrozenClone(&e1.frozen);
+            else
+                e1.poly = PolyClone(&e1.poly);
+            CSPushEntry(cs, e1);
             break;
         case OPERATION_ADD:
             CSBinaryOperator(cs, PolyAdd);
             break;
         case OPERATION_MUL:
+            if (cs->checked)
+                return CSExecuteMulChecked(cs);
             CSBinaryOperator(cs, PolyMul);
             break;
         case OPERATION_NEG:
             PolyScaleInplace(CSTopPtr(cs), -1);
+            CSTopEntry(cs)->poly = CSInterned(cs, CSTopEntry(cs)->poly);
+            CSTopEntry(cs)->hash = 0;
             break;
         case OPERATION_SUB:
             CSBinaryOperator(cs, PolySub);
             break;
         case OPERATION_IS_EQ:
-            p1 = CSPopPolynomial(cs);
-            p2 = CSPopPolynomial(cs);
-            fprintf(out, "%i\n", (int)PolyIsEq(&p1, &p2));
-            CSPushPolynomial(cs, p2);
-            CSPushPolynomial(cs, p1);
+            e1 = CSPopEntry(cs);
+            e2 = CSPopEntry(cs);
+            fprintf(out, "%i\n", (int)CSEntriesEqual(&e1, &e2));
+            CSPushEntry(cs, e2);
+            CSPushEntry(cs, e1);
+            break;
+        case OPERATION_IS_EQ_FAST:
+            e1 = CSPopEntry(cs);
+            e2 = CSPopEntry(cs);
+            if (e1.hash != 0 && e2.hash != 0 && e1.hash != e2.hash) {
+                fprintf(out, "0\n");
+            } else if (e1.isFrozen && e2.isFrozen) {
+                fprintf(out, "%i\n", (int)PolyFrozenIsEq(&e1.frozen, &e2.frozen));
+            } else {
+                Poly p2 = CSEntryPoly(&e2);
+                p1 = CSEntryPoly(&e1);
+                fprintf(out, "%i\n", (int)PolyIsEqProbable(&p1, &p2, CS_IS_EQ_FAST_ROUNDS));
+                PolyDestroy(&p1);
+                PolyDestroy(&p2);
+            }
+            CSPushEntry(cs, e2);
+            CSPushEntry(cs, e1);
             break;
         case OPERATION_DEG:
-            fprintf(out, "%i\n", (int)PolyDeg(CSTopPtr(cs)));
+            e1 = *CSTopEntry(cs);
+            fprintf(out, "%i\n", (int)(e1.isFrozen ? PolyFrozenDeg(&e1.frozen) : PolyDeg(&e1.poly)));
             break;
         case OPERATION_DEG_BY:
-            fprintf(out, "%i\n", (int)PolyDegBy(CSTopPtr(cs), cs->uiArg));
+            e1 = *CSTopEntry(cs);
+            fprintf(out, "%i\n", (int)(e1.isFrozen ? PolyFrozenDegBy(&e1.frozen, cs->uiArg)
+                                                    : PolyDegBy(&e1.poly, cs->uiArg)));
             break;
         case OPERATION_AT:
             p1 = CSPopPolynomial(cs);
@@ -276,16 +666,51 @@ void CSExecute(CalculatorStack *cs, CSOperation op, FILE *out) {
             PolyDestroy(&p1);
             break;
         case OPERATION_PRINT:
-            PolyPrint(CSTopPtr(cs), out);
+            e1 = *CSTopEntry(cs);
+            if (e1.isFrozen)
+                PolyFrozenPrint(&e1.frozen, out);
+            else
+                PolyPrint(&e1.poly, out);
             fputc('\n', out);
             break;
         case OPERATION_POP:
-            PolyDestroy(CSTopPtr(cs));
-            CSPopPolynomial(cs);
+            e1 = CSPopEntry(cs);
+            CSEntryDestroy(&e1);
             break;
         case OPERATION_COMPOSE:
-            CSExecuteCompose(cs);
+            return CSExecuteCompose(cs);
+        case OPERATION_SHIFT:
+            p1 = CSPopPolynomial(cs);
+            CSPushPolynomial(cs, PolyShift(&p1, cs->pcArg));
+            PolyDestroy(&p1);
+            break;
+        case OPERATION_POW:
+            p1 = CSPopPolynomial(cs);
+            CSPushPolynomial(cs, PolyPow(&p1, (poly_exp_t)cs->uiArg));
+            PolyDestroy(&p1);
+            break;
+        case OPERATION_MOD:
+            CSExecuteMod(cs);
+            break;
+        case OPERATION_EXACT:
+            CSExecuteExact(cs);
+            break;
+        case OPERATION_CHECKED:
+            cs->checked = cs->uiArg != 0;
+            break;
+        case OPERATION_INTERN:
+            cs->interned = cs->uiArg != 0;
+            if (cs->interned)
+                CSApplyAll(cs, PolyIntern);
+            break;
+        case OPERATION_CACHE_CLEAR:
+            PolyCacheClear();
+            break;
+        case OPERATION_FREEZE:
+            cs->frozen = cs->uiArg != 0;
+            CSApplyAll(cs, PolyClone);
             break;
     }
+    return true;
 }
 
@@ -6,6 +6,16 @@
 #ifndef WIELOMIANY_CALCULATOR_STACK_H
 #define WIELOMIANY_CALCULATOR_STACK_H
 
+#ifdef POLY_SYMBOL_PREFIX
+//Stos kalkulatora zależy od szerokości współczynników, więc dostaje ten sam prefiks co biblioteka
+#define CSOperationFromString POLY_PREFIXED(CSOperationFromString)
+#define CSInit POLY_PREFIXED(CSInit)
+#define CSDestroy POLY_PREFIXED(CSDestroy)
+#define CSPushPolynomial POLY_PREFIXED(CSPushPolynomial)
+#define CSCanExecute POLY_PREFIXED(CSCanExecute)
+#define CSExecute POLY_PREFIXED(CSExecute)
+#endif
+
 
 /**
  * Struktura przechowująca dane stosu kalkulatora.
@@ -18,12 +28,23 @@ typedef struct {
     ///Liczba wszystkich elementów na stosie
     uint32_t size;
 
-    ///Argument dodatkowy dla operacji <c>OPERATION_DEG_BY</c> oraz <c>OPERATION_COMPOSE</c>
+    ///Argument dodatkowy dla operacji <c>OPERATION_DEG_BY</c>, <c>OPERATION_COMPOSE</c>, <c>OPERATION_POW</c>,
+    ///<c>OPERATION_EXACT</c>, <c>OPERATION_CHECKED</c>, <c>OPERATION_INTERN</c> oraz <c>OPERATION_FREEZE</c>
     unsigned int uiArg;
 
-    ///Argument dodatkowy dla operacji <c>OPERATION_AT</c>
+    ///Argument dodatkowy dla operacji <c>OPERATION_AT</c>, <c>OPERATION_SHIFT</c> oraz <c>OPERATION_MOD</c>
     poly_coeff_t pcArg;
 
+    ///Czy <c>OPERATION_MUL</c> i <c>OPERATION_COMPOSE</c> wykrywają przepełnienie (PolyMulChecked(),
+    ///PolyComposeChecked())
+    bool checked;
+
+    ///Czy wielomiany odkładane na stos są internowane (PolyIntern())
+    bool interned;
+
+    ///Czy elementy stosu poniżej wierzchołka są przechowywane w postaci zamrożonej (PolyFreeze())
+    bool frozen;
+
     ///Wskaźnik na wierzchni segment stosu
     struct CSStackHunk *topHunk;
 
@@ -63,9 +84,14 @@ typedef enum {
     ///Odejmuje od wielomianu z wierzchołka wielomian pod wierzchołkiem, usuwa je i wstawia na wierzchołek stosu różnicę
     OPERATION_SUB,
 
-    ///Wprawdza, czy dwa wielomiany na wierzchu stosu są równe – wypisuje na standardowe wyjście 0 lub 1
+    ///Wprawdza, czy dwa wielomiany na wierzchu stosu są równe – wypisuje na standardowe wyjście 0 lub 1;
+    ///najpierw porównywane są zapamiętane na stosie skróty wielomianów (PolyHash())
     OPERATION_IS_EQ,
 
+    ///Probabilistycznie sprawdza (PolyIsEqProbable()), czy dwa wielomiany na wierzchu stosu są równe – wypisuje na
+    ///standardowe wyjście 0 lub 1
+    OPERATION_IS_EQ_FAST,
+
     ///Wypisuje na standardowe wyjście stopień wielomianu (−1 dla wielomianu tożsamościowo równego zeru)
     OPERATION_DEG,
 
@@ -89,6 +115,50 @@ typedef enum {
     ///Składa wielomiany metodą PolyCompose; wymaga ustawienia wartości odpowiedniego oapametru
     ///@see CSSetUIArg()
     OPERATION_COMPOSE,
+
+    ///Przesuwa wielomian z wierzchołka stosu o a względem zmiennej głównej (wstawia \f$ p(x_0 + a, x_1, \ldots) \f$);
+    ///wymaga ustawienia wartości odpowiedniego parametru typu <c>poly_coeff_t</c>
+    ///@see CSSetPCArg()
+    OPERATION_SHIFT,
+
+    ///Podnosi wielomian z wierzchołka stosu do potęgi metodą PolyPow; wymaga ustawienia wartości odpowiedniego
+    ///parametru typu <c>unsigned int</c> (nie większej niż <c>INT_MAX</c>)
+    ///@see CSSetUIArg()
+    OPERATION_POW,
+
+    ///Przełącza kalkulator na arytmetykę modulo liczba pierwsza p (PolySetModulus()) i redukuje wszystkie wielomiany na
+    ///stosie; p = 0 przywraca zwykłą arytmetykę; wymaga ustawienia wartości odpowiedniego parametru typu
+    ///<c>poly_coeff_t</c> spełniającej PolyIsValidModulus()
+    ///@see CSSetPCArg()
+    OPERATION_MOD,
+
+    ///Włącza (1) lub wyłącza (0) dokładną arytmetykę współczynników (PolySetExactCoefficients()); przy wyłączaniu
+    ///współczynniki wielomianów na stosie są sprowadzane do zakresu <c>poly_coeff_t</c>; wymaga ustawienia wartości
+    ///odpowiedniego parametru typu <c>unsigned int</c>
+    ///@see CSSetUIArg()
+    OPERATION_EXACT,
+
+    ///Włącza (1) lub wyłącza (0) wykrywanie przepełnień w operacjach <c>OPERATION_MUL</c> i <c>OPERATION_COMPOSE</c>;
+    ///przy przepełnieniu operacja nie zmienia stosu; wymaga ustawienia wartości odpowiedniego parametru typu
+    ///<c>unsigned int</c>
+    ///@see CSSetUIArg()
+    OPERATION_CHECKED,
+
+    ///Włącza (1) lub wyłącza (0) internowanie wielomianów na stosie (PolyIntern()); przy włączaniu internowane są też
+    ///wielomiany, które już są na stosie; wymaga ustawienia wartości odpowiedniego parametru typu <c>unsigned int</c>
+    ///@see CSSetUIArg()
+    OPERATION_INTERN,
+
+    ///Usuwa wszystkie wyniki z pamięci podręcznej działań (PolyCacheClear()); wyniki są zapamiętywane tylko dla
+    ///internowanych wielomianów (<c>OPERATION_INTERN</c>)
+    OPERATION_CACHE_CLEAR,
+
+    ///Włącza (1) lub wyłącza (0) przechowywanie elementów stosu w postaci zamrożonej (PolyFreeze()): element jest
+    ///zamrażany, gdy przykryje go kolejny, i rozmrażany, gdy potrzebuje go działanie arytmetyczne; operacje tylko
+    ///czytające wielomian działają na postaci zamrożonej; nie dotyczy stosu internującego (<c>OPERATION_INTERN</c>);
+    ///wymaga ustawienia wartości odpowiedniego parametru typu <c>unsigned int</c>
+    ///@see CSSetUIArg()
+    OPERATION_FREEZE,
 } CSOperation;
 
 
@@ -141,12 +211,16 @@ bool CSCanExecute(CalculatorStack *cs, CSOperation op);
  * @param cs stosk klakulatora
  * @param op kod operacji
  * @param out plik wyjściowy, potrzebny operacjom wypisującym dane (<c>OPERATION_IS_ZERO</c>, <c>OPERATION_IS_COEFF</c>,
- * <c>OPERATION_IS_EQ</c>, <c>OPERATION_DEG</c>, <c>OPERATION_DEG_BY</c>, <c>OPERATION_PRINT</c>
+ * <c>OPERATION_IS_EQ</c>, <c>OPERATION_IS_EQ_FAST</c>, <c>OPERATION_DEG</c>, <c>OPERATION_DEG_BY</c>,
+ * <c>OPERATION_PRINT</c>
+ * @return <c>false</c>, gdy wynik operacji nie mieści się w <c>poly_coeff_t</c> (tylko po włączeniu
+ * <c>OPERATION_CHECKED</c>); stos nie jest wtedy zmieniany
  */
-void CSExecute(CalculatorStack *cs, CSOperation op, FILE *out);
+bool CSExecute(CalculatorStack *cs, CSOperation op, FILE *out);
 
 /**
- * Ustawia dodatkowy argument dla wszystkich kolejnych operacji <c>OPERATION_DEG_BY</c> oraz <c>OPERATION_COMPOSE</c>.
+ * Ustawia dodatkowy argument dla wszystkich kolejnych operacji <c>OPERATION_DEG_BY</c>, <c>OPERATION_COMPOSE</c>
+ * oraz <c>OPERATION_POW</c>.
  * Wszystkie te operacje będą używały tego argumentu, az do kolejnego wywołania tej metody z inną wartoscią.
  * @param cs struktura stosu
  * @param arg wartosć argumentu
@@ -157,7 +231,8 @@ static inline void CSSetUIArg(CalculatorStack *cs, unsigned int arg)
 }
 
 /**
- * Ustawia argument dla wszystkich kolejnych operacji <c>OPERATION_AT</c>.
+ * Ustawia argument dla wszystkich kolejnych operacji <c>OPERATION_AT</c>, <c>OPERATION_SHIFT</c> oraz
+ * <c>OPERATION_MOD</c>.
  * Wszystkie te operacje będą używały tego argumentu, az do kolejnego wywołania tej metody z inną wartoscią.
  * @param cs struktura stosu
  * @param arg wartosć argumentu
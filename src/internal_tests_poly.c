@@ -0,0 +1,392 @@
+/** @file internal_tests_poly.c
+ * Testy wewnętrznych ścieżek biblioteki, których nie da się sprawdzić testami z CMocka: algorytmów wielowątkowych
+ * (atrapy alokatora z CMocki nie są bezpieczne wątkowo) oraz puli tablic jednomianów i areny (w testach z CMocka
+ * zastępuje je zwykły malloc). Plik dołącza poly.c, żeby mieć dostęp do funkcji statycznych, i jest budowany bez
+ * UNIT_TESTING.
+ */
+#include <stdio.h>
+#include "poly.c"
+
+
+//**********************************************************************************************************************
+// internal_tests/test_utils
+
+///Liczba niespełnionych sprawdzeń
+static int InternalTestsFailed = 0;
+
+/**
+ * Sprawdza warunek; gdy nie jest spełniony, wypisuje miejsce sprawdzenia i zlicza błąd.
+ * @param condition warunek
+ */
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++InternalTestsFailed; \
+        } \
+    } while (0)
+
+
+///Stan generatora liczb pseudolosowych testów
+static uint64_t InternalTestsSeed = 1;
+
+
+/**
+ * Zwraca kolejną liczbę pseudolosową (xorshift64).
+ * @param bound górne ograniczenie (wyłącznie)
+ * @return liczba z przedziału <c>[0, bound)</c>
+ */
+static uint64_t NextRandom(uint64_t bound)
+{
+    InternalTestsSeed ^= InternalTestsSeed << 13;
+    InternalTestsSeed ^= InternalTestsSeed >> 7;
+    InternalTestsSeed ^= InternalTestsSeed << 17;
+    return InternalTestsSeed % bound;
+}
+
+
+/**
+ * Tworzy pseudolosowy wielomian.
+ * @param depth liczba zmiennych
+ * @param terms maksymalna liczba jednomianów na każdym poziomie
+ * @param max_exp maksymalny wykładnik
+ * @return wielomian
+ */
+static Poly MakeRandomPoly(unsigned depth, poly_exp_t terms, poly_exp_t max_exp)
+{
+    if (depth == 0)
+        return PolyFromCoeff((poly_coeff_t)NextRandom(19) - 9);
+    poly_exp_t length = 1 + (poly_exp_t)NextRandom((uint64_t)terms);
+    Mono *monos = malloc(sizeof(Mono) * (size_t)length);
+    assert(monos != NULL);
+    for (poly_exp_t i = 0; i < length; ++i) {
+        Poly coef = MakeRandomPoly(depth - 1, terms, max_exp);
+        monos[i] = MonoFromPoly(&coef, (poly_exp_t)NextRandom((uint64_t)max_exp + 1));
+    }
+    Poly p = PolyAddMonos(length, monos);
+    free(monos);
+    return p;
+}
+
+
+//**********************************************************************************************************************
+// internal_tests/compose_parallel
+/**
+ * Tworzy wielomian o <c>length</c> jednomianach najwyższego poziomu, złożony jednomian po jednomianie na wielu wątkach.
+ * @param length liczba jednomianów najwyższego poziomu
+ * @return wielomian
+ */
+static Poly MakeComposeSample(poly_exp_t length)
+{
+    Mono *monos = malloc(sizeof(Mono) * (size_t)length);
+    assert(monos != NULL);
+    for (poly_exp_t i = 0; i < length; ++i) {
+        Poly coef = MakeRandomPoly(2, 3, 3);
+        monos[i] = MonoFromPoly(&coef, i);
+    }
+    Poly p = PolyAddMonos(length, monos);
+    free(monos);
+    return p;
+}
+
+
+/**
+ * Złożenie wielomianu o co najmniej <c>POLY_PARALLEL_COMPOSE_THRESHOLD</c> jednomianach najwyższego poziomu na
+ * czterech wątkach jest równe złożeniu na jednym wątku, także w arytmetyce modularnej i przy wielokrotnym użyciu puli
+ * wątków.
+ */
+static void TestComposeParallel(void)
+{
+    const uint64_t moduli[] = {0, 1000003};
+    for (size_t m = 0; m < sizeof(moduli) / sizeof(moduli[0]); ++m) {
+        PolySetModulus(moduli[m]);
+        for (int round = 0; round < 4; ++round) {
+            Poly p = MakeComposeSample(POLY_PARALLEL_COMPOSE_THRESHOLD + 8 * round);
+            Poly subs[] = {MakeRandomPoly(2, 3, 2), MakeRandomPoly(1, 3, 2), MakeRandomPoly(2, 2, 2)};
+
+            PolySetThreadCount(1);
+            Poly expect = PolyComposeSymbolic(&p, 3, subs);
+            PolySetThreadCount(4);
+            Poly parallel = PolyComposeParallel(&p, 3, subs);
+            Poly composed = PolyCompose(&p, 3, subs);
+            CHECK(PolyIsEq(&parallel, &expect));
+            CHECK(PolyIsEq(&composed, &expect));
+
+            PolyDestroy(&p);
+            for (size_t i = 0; i < sizeof(subs) / sizeof(subs[0]); ++i)
+                PolyDestroy(subs + i);
+            PolyDestroy(&expect);
+            PolyDestroy(&parallel);
+            PolyDestroy(&composed);
+        }
+    }
+    PolySetModulus(0);
+    PolySetThreadCount(0);
+}
+
+
+/**
+ * Suma k-krotna (z sumami znoszącymi się do zera i składnikami będącymi współczynnikami) jest równa sumie liczonej
+ * parami.
+ */
+static void TestSumMany(void)
+{
+    PolySetThreadCount(4);
+    for (int round = 0; round < 20; ++round) {
+        size_t count = 1 + NextRandom(40);
+        Poly terms[40], copies[40];
+        Poly expect = PolyZero();
+        for (size_t i = 0; i < count; ++i) {
+            if (i % 2 == 1 && NextRandom(2) == 0)
+                terms[i] = PolyNeg(terms + i - 1);
+            else
+                terms[i] = MakeRandomPoly(NextRandom(3), 4, 4);
+            copies[i] = PolyClone(terms + i);
+            Poly next = PolyAdd(&expect, terms + i);
+            PolyDestroy(&expect);
+            expect = next;
+        }
+
+        Poly sequential = PolySumMany(terms, count, false);
+        Poly parallel = PolySumMany(copies, count, true);
+        CHECK(PolyIsEq(&sequential, &expect));
+        CHECK(PolyIsEq(&parallel, &expect));
+        CHECK(PolyIsCoeff(&parallel) || !PolyIsZero(&parallel.monos[0].p));
+
+        PolyDestroy(&expect);
+        PolyDestroy(&sequential);
+        PolyDestroy(&parallel);
+    }
+    PolySetThreadCount(0);
+}
+
+
+/**
+ * Dane wątku w teście równoległych wywołań PolyCompose().
+ */
+typedef struct
+{
+    ///Składany wielomian
+    const Poly *p;
+
+    ///Podstawienia
+    const Poly *subs;
+
+    ///Wynik
+    Poly result;
+} ComposeCall;
+
+
+/**
+ * Wątek wywołujący PolyCompose().
+ * @param arg wskaźnik na <c>ComposeCall</c>
+ * @return <c>NULL</c>
+ */
+static void *ComposeThread(void *arg)
+{
+    ComposeCall *call = arg;
+    call->result = PolyCompose(call->p, 2, call->subs);
+    return NULL;
+}
+
+
+/**
+ * Równoczesne wywołania z kilku wątków dzielą jedną pulę wątków roboczych: wywołanie, które zastanie pulę zajętą,
+ * liczy na swoim wątku.
+ */
+static void TestComposeConcurrentCallers(void)
+{
+    Poly p = MakeComposeSample(2 * POLY_PARALLEL_COMPOSE_THRESHOLD);
+    Poly subs[] = {MakeRandomPoly(1, 3, 2), MakeRandomPoly(2, 3, 2)};
+    PolySetThreadCount(1);
+    Poly expect = PolyComposeSymbolic(&p, 2, subs);
+    PolySetThreadCount(4);
+
+    ComposeCall calls[3];
+    pthread_t threads[3];
+    for (size_t i = 0; i < 3; ++i) {
+        calls[i] = (ComposeCall){.p = &p, .subs = subs};
+        CHECK(pthread_create(threads + i, NULL, ComposeThread, calls + i) == 0);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        pthread_join(threads[i], NULL);
+        CHECK(PolyIsEq(&calls[i].result, &expect));
+        PolyDestroy(&calls[i].result);
+    }
+
+    PolyDestroy(&p);
+    PolyDestroy(subs + 0);
+    PolyDestroy(subs + 1);
+    PolyDestroy(&expect);
+    PolySetThreadCount(0);
+}
+
+
+//**********************************************************************************************************************
+// internal_tests/from_monos_parallel
+/**
+ * Sortowanie i scalanie co najmniej <c>POLY_PARALLEL_SORT_THRESHOLD</c> nieposortowanych jednomianów na wielu
+ * wątkach daje ten sam wielomian co na jednym wątku. Długie serie równych wykładników przechodzą przez granice
+ * fragmentów, a współczynniki są wielomianami (także znoszącymi się), więc scalanie wymaga rekurencyjnego PolyAdd().
+ */
+static void TestFromMonosParallel(void)
+{
+    const poly_exp_t length = POLY_PARALLEL_SORT_THRESHOLD + 1001;
+    Poly coefs[8];
+    for (size_t i = 0; i < 4; ++i) {
+        coefs[2 * i] = MakeRandomPoly(2, 3, 3);
+        coefs[2 * i + 1] = PolyNeg(coefs + 2 * i);
+    }
+
+    Mono *monos = malloc(sizeof(Mono) * (size_t)length);
+    assert(monos != NULL);
+    for (poly_exp_t i = 0; i < length; ++i) {
+        //Połowa jednomianów ma wykładnik 7, reszta tworzy serie po 5000 jednomianów o równych wykładnikach
+        poly_exp_t exp = i % 2 == 0 ? 7 : 100 + i / 10000;
+        Poly coef = PolyClone(coefs + NextRandom(8));
+        monos[i] = MonoFromPoly(&coef, exp);
+    }
+    for (poly_exp_t i = length - 1; i > 0; --i) {
+        poly_exp_t j = (poly_exp_t)NextRandom((uint64_t)i + 1);
+        Mono swap = monos[i];
+        monos[i] = monos[j];
+        monos[j] = swap;
+    }
+
+    PolySetThreadCount(1);
+    Poly expect = PolyAddCopiedMonos((unsigned)length, monos);
+    const unsigned threads[] = {2, 3, 4};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+        PolySetThreadCount(threads[t]);
+        Mono *copy = MonosAlloc((size_t)length);
+        assert(copy != NULL);
+        for (poly_exp_t i = 0; i < length; ++i)
+            copy[i] = MonoClone(monos + i);
+        Poly parallel = PolyFromMonosParallel(copy, length);
+        Poly added = PolyAddCopiedMonos((unsigned)length, monos);
+        CHECK(PolyIsEq(&parallel, &expect));
+        CHECK(PolyIsEq(&added, &expect));
+        PolyDestroy(&parallel);
+        PolyDestroy(&added);
+    }
+    PolySetThreadCount(0);
+
+    for (poly_exp_t i = 0; i < length; ++i)
+        MonoDestroy(monos + i);
+    free(monos);
+    for (size_t i = 0; i < 8; ++i)
+        PolyDestroy(coefs + i);
+    PolyDestroy(&expect);
+}
+
+
+#ifndef POLY_USE_MALLOC
+//**********************************************************************************************************************
+// internal_tests/arena
+/**
+ * Sprawdza, czy któraś z tablic jednomianów wielomianu pochodzi z areny.
+ * @param p wielomian
+ * @return czy wielomian zawiera tablicę klasy <c>POLY_ARENA_SIZE_CLASS</c>
+ */
+static bool HasArenaArrays(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return false;
+    if (PolyPoolHeader(p->monos)->size_class == POLY_ARENA_SIZE_CLASS)
+        return true;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (HasArenaArrays(&p->monos[i].p))
+            return true;
+    }
+    return false;
+}
+
+
+/**
+ * Liczy w zakresie areny iloczyn, a potem tyle tymczasowych iloczynów, żeby arena zajęła więcej niż jeden blok
+ * (bloków o rozmiarze <c>POLY_ARENA_CHUNK_BYTES</c>).
+ * @param p czynnik
+ * @param q czynnik
+ * @return iloczyn \f$ p q \f$ z tablicami z areny
+ */
+static Poly MulInArena(const Poly *p, const Poly *q)
+{
+    Poly result = PolyMul(p, q);
+    //Zakres areny zaczyna od pierwszego bloku, także gdy arena była już używana
+    CHECK(HasArenaArrays(&result) && PolyArena.current == PolyArena.first);
+    for (int i = 0; i < 1000 && PolyArena.current == PolyArena.first; ++i) {
+        Poly temporary = PolyMul(q, p);
+        PolyDestroy(&temporary);
+    }
+    CHECK(PolyArena.current != PolyArena.first);
+    return result;
+}
+
+
+/**
+ * Wynik zakresu areny, która zajęła kilka bloków, nie ma tablic z areny, pozostaje poprawny po wyczyszczeniu areny i
+ * jej ponownym użyciu, a ponowne użycie nie przydziela nowych bloków.
+ */
+static void TestArenaPromote(void)
+{
+    const unsigned threads[] = {1, 4};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+        PolySetThreadCount(threads[t]);
+        Poly p = MakeRandomPoly(3, 6, 4);
+        Poly q = MakeRandomPoly(3, 6, 4);
+        Poly expect = PolyMul(&p, &q);
+
+        PolyArenaBegin();
+        Poly result = MulInArena(&p, &q);
+        PolyArenaEnd(&result);
+        CHECK(!HasArenaArrays(&result));
+        CHECK(PolyIsEq(&result, &expect));
+
+        size_t chunks = PolyArena.chunks;
+        PolyArenaBegin();
+        Poly other = MulInArena(&q, &p);
+        PolyDestroy(&other);
+        PolyArenaEnd(NULL);
+        CHECK(PolyArena.chunks == chunks);
+        CHECK(PolyIsEq(&result, &expect));
+
+        PolyArenaBegin();
+        Poly again = MulInArena(&q, &p);
+        PolyArenaEnd(&again);
+        CHECK(!HasArenaArrays(&again));
+        CHECK(PolyIsEq(&again, &expect));
+        CHECK(PolyIsEq(&result, &expect));
+
+        PolyDestroy(&p);
+        PolyDestroy(&q);
+        PolyDestroy(&expect);
+        PolyDestroy(&result);
+        PolyDestroy(&again);
+    }
+    PolySetThreadCount(0);
+}
+#endif
+
+
+//**********************************************************************************************************************
+// internal_tests/tests_main
+/**
+ * Uruchamia testy.
+ * @return 0, gdy wszystkie sprawdzenia się powiodły
+ */
+int main(void)
+{
+    TestComposeParallel();
+    TestSumMany();
+    TestComposeConcurrentCallers();
+    TestFromMonosParallel();
+#ifndef POLY_USE_MALLOC
+    TestArenaPromote();
+#endif
+
+    if (InternalTestsFailed != 0)
+        fprintf(stderr, "%d checks failed\n", InternalTestsFailed);
+    else
+        printf("All internal tests passed\n");
+    return InternalTestsFailed != 0;
+}
@@ -8,15 +8,54 @@
 #define EXITCODE_INVALID_INVOCATION 1
 #define EXITCODE_FILE_SYNTAX_ERROR 2
 
+///Przedrostek opcji wybierającej szerokość współczynników kalkulatora
+#define COEFF_BITS_OPTION "--coeff-bits="
+
+///Funkcja wykonująca polecenia kalkulatora ze strumienia wejściowego (ParserRun() jednego z wariantów)
+typedef bool (*CalculatorRun)(FILE *source, FILE *output);
+
+
+#ifdef CALC_POLY_COEFF32
+/**
+ * ParserRun() wariantu kalkulatora z 32-bitowymi współczynnikami, skompilowanego z prefiksem <c>Poly32_</c>.
+ * @param source plik źródłowy z poleceniami
+ * @param output strumień wyjściowy dla polecenia <c>PRINT</c>
+ * @return <c>true</c> kiedy cały plik został pomyślnie sparsowany i wykonany; <c>false</c> w.p.p.
+ */
+bool Poly32_ParserRun(FILE *source, FILE *output);
+#endif
+
+
+/**
+ * Wybiera wariant kalkulatora na podstawie opcji <c>--coeff-bits=</c>.
+ * @param option wartość opcji z linii poleceń
+ * @return funkcja wykonująca polecenia w wybranym wariancie; <c>NULL</c>, gdy opcja jest niepoprawna albo wariant
+ * nie został dołączony do programu
+ */
+static CalculatorRun SelectVariant(const char *option)
+{
+    if (strncmp(option, COEFF_BITS_OPTION, strlen(COEFF_BITS_OPTION)) != 0)
+        return NULL;
+    const char *bits = option + strlen(COEFF_BITS_OPTION);
+    if (strcmp(bits, POLY_COEFF_BITS == 64 ? "64" : "32") == 0)
+        return ParserRun;
+#ifdef CALC_POLY_COEFF32
+    if (strcmp(bits, "32") == 0)
+        return Poly32_ParserRun;
+#endif
+    return NULL;
+}
 
 
 int main(int argc, const char **argv)
 {
-    Parser parser = ParserInit();
-    ParserPrepare(&parser, stdin, stdout);
-    if (!ParserExecuteAll(&parser, true))
-        return EXITCODE_FILE_SYNTAX_ERROR;
-    ParserDestroy(&parser);
+    CalculatorRun run = argc == 2 ? SelectVariant(argv[1]) : ParserRun;
+    if (argc > 2 || run == NULL) {
+        fprintf(stderr, "Usage: %s [" COEFF_BITS_OPTION "64|" COEFF_BITS_OPTION "32]\n", argv[0]);
+        return EXITCODE_INVALID_INVOCATION;
+    }
 
+    if (!run(stdin, stdout))
+        return EXITCODE_FILE_SYNTAX_ERROR;
     return EXITCODE_NO_ERROR;
 }
@@ -144,17 +144,20 @@ static bool ParseExponent(Parser *p, poly_exp_t *out, uint32_t *invalid_digit)
 /**
  * Patarsuje i ustawia na stosie operacji argument typu <c>unsigned int</c>.
  * @param p struktura parsera
+ * @param max_value największa dopuszczalna wartość argumentu
+ * @param error_message komunikat wypisywany w przypadku błędu
  * @return feedback parsowania
  */
-static bool ParseAndPushUIntParameter(Parser *p, const char *error_message)
+static bool ParseAndPushUIntParameter(Parser *p, unsigned int max_value, const char *error_message)
 {
     if (!LexerExpectChar(&p->lexer, ' ') || p->lexer.tokenType != TOKEN_NUMBER) {
         fprintf(stderr, "ERROR %u %s\n", (unsigned int)p->lexer.startLine, error_message);
         return false;
     }
+    errno = 0;
     long unsigned int arg = strtoul(p->lexer.tokenBuffer, NULL, 10);
     LexerReadNextToken(&p->lexer);
-    if (errno == ERANGE || arg > UINT_MAX || p->lexer.tokenBuffer[0] != '\n') {
+    if (errno == ERANGE || arg > max_value || p->lexer.tokenBuffer[0] != '\n') {
         fprintf(stderr, "ERROR %u %s\n", (unsigned int)p->lexer.startLine, error_message);
         return false;
     }
@@ -181,15 +184,30 @@ static bool ParseCommand(Parser *p)
     op_code = CSOperationFromString(p->lexer.tokenBuffer);
     LexerReadNextToken(&p->lexer);
 
-    if (op_code == OPERATION_AT) {
+    if (op_code == OPERATION_AT || op_code == OPERATION_SHIFT) {
         poly_coeff_t arg = 0;
         if (!LexerExpectChar(&p->lexer, ' ') || !ParseCoefficient(p, &arg, NULL) || p->lexer.tokenBuffer[0] != '\n') {
             fprintf(stderr, "ERROR %u WRONG VALUE\n", (unsigned int)p->lexer.startLine);
             return false;
         }
         CSSetPCArg(&p->stack, arg);
+    } else if (op_code == OPERATION_MOD) {
+        poly_coeff_t arg = 0;
+        if (!LexerExpectChar(&p->lexer, ' ') || !ParseCoefficient(p, &arg, NULL) || p->lexer.tokenBuffer[0] != '\n'
+            || !PolyIsValidModulus(arg)) {
+            fprintf(stderr, "ERROR %u WRONG MODULUS\n", (unsigned int)p->lexer.startLine);
+            return false;
+        }
+        CSSetPCArg(&p->stack, arg);
     } else if (op_code == OPERATION_DEG_BY || op_code == OPERATION_COMPOSE) {
-        if (!ParseAndPushUIntParameter(p, op_code == OPERATION_DEG_BY ? "WRONG VARIABLE" : "WRONG COUNT"))
+        if (!ParseAndPushUIntParameter(p, UINT_MAX, op_code == OPERATION_DEG_BY ? "WRONG VARIABLE" : "WRONG COUNT"))
+            return false;
+    } else if (op_code == OPERATION_POW) {
+        if (!ParseAndPushUIntParameter(p, INT_MAX, "WRONG EXPONENT"))
+            return false;
+    } else if (op_code == OPERATION_EXACT || op_code == OPERATION_CHECKED || op_code == OPERATION_INTERN
+               || op_code == OPERATION_FREEZE) {
+        if (!ParseAndPushUIntParameter(p, 1, "WRONG VALUE"))
             return false;
     } else {
         if (op_code == OPERATION_INVALID || p->lexer.tokenBuffer[0] != '\n') {
@@ -202,7 +220,10 @@ static bool ParseCommand(Parser *p)
         fprintf(stderr, "ERROR %u STACK UNDERFLOW\n", (unsigned int)p->lexer.startLine);
         return false;
     }
-    CSExecute(&p->stack, op_code, p->output);
+    if (!CSExecute(&p->stack, op_code, p->output)) {
+        fprintf(stderr, "ERROR %u OVERFLOW\n", (unsigned int)p->lexer.startLine);
+        return false;
+    }
     return true;
 }
 
@@ -290,7 +311,13 @@ static bool ParsePolynomial(Parser *p, Poly *out)
             fprintf(stderr, "ERROR %u %u\n", p->lexer.startLine, p->lexer.startColumn + error_offset);
             return false;
         }
+        //Przy ustawionym module współczynniki są redukowane od razu, bo PolyAddMonos() dodaje je już modulo
         *out = PolyFromCoeff(coef);
+        if (PolyGetModulus() != 0) {
+            Poly reduced = PolyReduce(out);
+            PolyDestroy(out);
+            *out = reduced;
+        }
         return true;
     }
 }
@@ -348,6 +375,15 @@ bool ParserExecuteAll(Parser *parser, bool error_resume_next) {
 }
 
 
+bool ParserRun(FILE *source, FILE *output) {
+    Parser parser = ParserInit();
+    ParserPrepare(&parser, source, output);
+    bool result = ParserExecuteAll(&parser, true);
+    ParserDestroy(&parser);
+    return result;
+}
+
+
 Parser ParserInit(void) {
     Parser result;
     result.stack = CSInit();
@@ -9,6 +9,15 @@
 #include "lexer.h"
 #include "calculator_stack.h"
 
+#ifdef POLY_SYMBOL_PREFIX
+//Parser zależy od szerokości współczynników, więc dostaje ten sam prefiks co biblioteka
+#define ParserInit POLY_PREFIXED(ParserInit)
+#define ParserDestroy POLY_PREFIXED(ParserDestroy)
+#define ParserPrepare POLY_PREFIXED(ParserPrepare)
+#define ParserExecuteAll POLY_PREFIXED(ParserExecuteAll)
+#define ParserRun POLY_PREFIXED(ParserRun)
+#endif
+
 
 /**
  * Reprezentacja bierzącego stanu parsera.
@@ -68,5 +77,15 @@ void ParserPrepare(Parser *parser, FILE *source, FILE *output);
  */
 bool ParserExecuteAll(Parser *parser, bool error_resume_next);
 
+/**
+ * Wykonuje wszystkie polecenia z pliku na nowym parserze, kontynuując po błędach składniowych.
+ * Jedyna funkcja parsera potrzebna programowi, który wybiera wariant kalkulatora o danej szerokości współczynników:
+ * jej deklaracja nie zależy od <c>poly_coeff_t</c>.
+ * @param source plik źródłowy z poleceniami
+ * @param output strumień wyjściowy dla polecenia <c>PRINT</c>
+ * @return <c>true</c> kiedy cały plik został pomyślnie sparsowany i wykonany; <c>false</c> w.p.p.
+ */
+bool ParserRun(FILE *source, FILE *output);
+
 
 #endif //WIELOMIANY_PARSER_H
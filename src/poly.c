@@ -3,7 +3,12 @@
  */
 #include <stdlib.h>
 #include <assert.h>
+#include <limits.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <time.h>
 #include "poly.h"
 #include "mock_tricks.h"
 
@@ -18,660 +23,5505 @@
 #define WILL_RUN_ILL_TESTS
 
 
+#ifdef UNIT_TESTING
+///Atrapy alokatora z CMocki nie są bezpieczne wątkowo, więc w testach jednostkowych liczymy na jednym wątku
+#define POLY_MAX_THREADS 1
+#endif
+
+#ifndef POLY_MAX_THREADS
+///Maksymalna liczba wątków używanych przez równoległe algorytmy biblioteki
+#define POLY_MAX_THREADS 64
+#endif
+
+#if defined(UNIT_TESTING) && !defined(POLY_USE_MALLOC) && !defined(POLY_UNIT_TESTING_POOL)
+///Atrapy alokatora z CMocki śledzą każdą tablicę, więc podstawowy wariant testów jednostkowych nie używa puli;
+///wariant z <c>POLY_UNIT_TESTING_POOL</c> sprawdza te same testy z pulą i areną
+#define POLY_USE_MALLOC
+#endif
+
+///Minimalna liczba jednomianów najwyższego poziomu, od której PolyCompose() liczy równolegle
+#define POLY_PARALLEL_COMPOSE_THRESHOLD 32
+
+///Maksymalna liczba punktów siatki, na której PolyCompose() może interpolować wynik
+#define POLY_INTERPOLATION_MAX_POINTS (1 << 20)
+
+///Ile razy mniejszy musi być szacowany koszt interpolacji od kosztu składania symbolicznego, żeby jej użyć
+#define POLY_INTERPOLATION_COST_FACTOR 4
+
+///Liczba punktów siatki obliczanych w jednym zadaniu puli wątków podczas interpolacji
+#define POLY_INTERPOLATION_CHUNK 256
+
+///Maksymalna liczba wyrazów podstawy potęgowanej przez rozwinięcie wielomianowe
+#define POLY_POW_MULTINOMIAL_MAX_TERMS 4
+
+///Maksymalny wykładnik rozwinięcia wielomianowego (ogranicza rozmiar trójkąta Pascala)
+#define POLY_POW_MULTINOMIAL_MAX_EXP 1024
+
+///Maksymalna liczba wyrazów generowanych przez rozwinięcie wielomianowe
+#define POLY_POW_MULTINOMIAL_MAX_RESULT (1 << 20)
+
+///Ile razy mniej wyrazów od objętości prostopadłościanu stopni musi mieć podstawa, by potęgować ją mnożeniem
+#define POLY_POW_SPARSE_FACTOR 4
+
+///Długość tablicy jednomianów, do której PolySortMonos() sortuje przez wstawianie
+#define POLY_INSERTION_SORT_THRESHOLD 16
+
+///Liczba bitów wykładnika przetwarzanych w jednym przebiegu sortowania pozycyjnego jednomianów
+#define POLY_RADIX_BITS 8
+
+///Maksymalna liczba posortowanych serii, które PolyFromMonos() scala zamiast sortować całą tablicę
+#define POLY_NATURAL_MERGE_MAX_RUNS 8
+
+///Minimalna długość tablicy jednomianów, od której PolyFromMonos() sortuje i scala równolegle
+#define POLY_PARALLEL_SORT_THRESHOLD (1 << 17)
+
+///Najdłuższa tablica jednomianów przydzielana z puli; każda długość do tej włącznie ma własną klasę rozmiaru
+#define POLY_POOL_MAX_LENGTH 64
+
+///Rozmiar bloku pamięci, który pula dzieli na tablice jednej klasy, gdy lista wolnych tablic się wyczerpie
+#define POLY_POOL_CHUNK_BYTES (1 << 16)
+
+///Rozmiar bloku, z którego arena (PolyArenaBegin()) kolejno wydziela tablice jednomianów
+#define POLY_ARENA_CHUNK_BYTES (1 << 18)
+
+///Największa liczba bloków areny jednego wątku; gdy się wyczerpią, tablice pochodzą z puli
+#define POLY_ARENA_MAX_CHUNKS 4
+
+///Klasa rozmiaru w nagłówku tablicy wydzielonej z areny; zwolnienie takiej tablicy nic nie robi
+#define POLY_ARENA_SIZE_CLASS INT32_MAX
+
+///Klasa rozmiaru we wspólnej, statycznej tablicy jednego jednomianu (PolyShareSmallTerm()); takiej tablicy się nie
+///zwalnia ani nie liczy do niej odwołań
+#define POLY_STATIC_SIZE_CLASS (INT32_MAX - 1)
+
+///Największa wartość bezwzględna współczynnika jednomianu \f$ c x^e \f$, który ma wspólną, statyczną tablicę
+#define POLY_SMALL_TERM_MAX_COEFF 8
+
+///Największy wykładnik jednomianu \f$ c x^e \f$, który ma wspólną, statyczną tablicę
+#define POLY_SMALL_TERM_MAX_EXP 15
+
+///Początkowa pojemność tablicy internowania (PolyIntern()); tablica rośnie dwukrotnie, gdy zapełni się w połowie
+#define POLY_INTERN_INITIAL_CAPACITY 1024
+
+///Domyślny budżet pamięci podręcznej działań w bajtach (PolySetCacheBudget())
+#define POLY_CACHE_DEFAULT_BUDGET ((size_t)64 << 20)
+
+///Najmniejsza łączna liczba jednomianów najwyższego poziomu argumentów PolyAdd() i PolyMul(), od której wynik trafia
+///do pamięci podręcznej działań; mniejsze działania kosztują mniej niż jej obsługa
+#define POLY_CACHE_MIN_LENGTH 4
+
+///Początkowa liczba kubełków pamięci podręcznej działań; liczba rośnie dwukrotnie, gdy wpisów jest więcej niż kubełków
+#define POLY_CACHE_INITIAL_BUCKETS 256
+
+///Wartość początkowa skrótu wielomianu, który nie jest współczynnikiem
+#define POLY_HASH_SEED 0x9e3779b97f4a7c15ULL
+
+///Liczba pierwsza Mersenne'a \f$ 2^{61} - 1 \f$, modulo której PolyIsEqProbable() wartościuje wielomiany
+#define POLY_PROBABLE_MODULUS ((UINT64_C(1) << 61) - 1)
+
+///Liczba bitów, na których musi się zmieścić moduł arytmetyki współczynników (mnożenie Montgomery'ego wymaga zapasu)
+#define POLY_MODULUS_BITS 62
+
+///Wartość pola <c>length</c> dużego współczynnika (pole <c>monos</c> wskazuje wtedy na <c>BigCoeff</c>)
+#define POLY_BIG_COEFF_LENGTH (-1)
+
+///Największa potęga 10 mieszcząca się w 64 bitach; duże współczynniki są wypisywane w kawałkach po 19 cyfr
+#define POLY_DECIMAL_CHUNK 10000000000000000000ULL
+
+#if POLY_COEFF_BITS == 64
+///Największa liczba modułów pierwszych, którymi PolyMulChecked() i PolyComposeChecked() weryfikują wynik
+#define POLY_CHECKED_MAX_PRIMES 8
+#else
+//Moduły z PolyCheckedPrimes nie mieszczą się w węższych współczynnikach, więc wynik jest wtedy liczony dokładnie
+#define POLY_CHECKED_MAX_PRIMES 0
+#endif
+
+///Każdy moduł z <c>PolyCheckedPrimes</c> jest większy od \f$ 2^{\text{POLY_CHECKED_PRIME_BITS}} \f$
+#define POLY_CHECKED_PRIME_BITS 61
+
+///Wartość, na której nasycają się oszacowania liczby bitów współczynników wyniku
+#define POLY_CHECKED_BITS_LIMIT UINT32_MAX
+
+///Iloczyn wielomianów-liści jest sumowany w tablicy gęstej, gdy rozpiętość jego wykładników nie przekracza tylu
+///iloczynów par jednomianów; w.p.p. pary są scalane kopcem
+#define POLY_LEAF_DENSE_FACTOR 2
+
+///Iloczyn wielomianów niebędących liśćmi jest zbierany w tablicy gęstej indeksowanej wykładnikiem, gdy rozpiętość
+///wykładników jego najwyższego poziomu nie przekracza tylu iloczynów par jednomianów; w.p.p. jest składany z sum
+///iloczynów przez jednomiany
+#define POLY_LEVEL_DENSE_FACTOR 2
+
+
+///Liczba wątków ustawiona przez PolySetThreadCount(); 0 oznacza liczbę dostępnych procesorów
+static atomic_uint PolyThreadCount = 0;
+
+///Licznik, z którego PolyIsEqProbable() wyprowadza ziarna kolejnych rund
+static atomic_uint_fast64_t PolyRandomCounter = 0;
+
+
 /**
- * Upraszcza wielomian, jeśli ten jest zerowy i zwraca ten wielomian (uproszczony wielomian, nie uproszczoną kopię).
- * @param p wielomian do uproszczenia
- * @return <code>p</code> po uptrzednim uproszczeniu
+ * Parametry arytmetyki współczynników modulo liczba pierwsza (mnożenie Montgomery'ego z \f$ R = 2^{64} \f$).
  */
-static Poly PolySimplifyCoeff(Poly p)
+typedef struct
 {
-    if (p.monos != NULL) {
-        bool first_zero = PolyIsZero(&p.monos[0].p);
-        bool other_zeros = true;
-        for (poly_exp_t i = 1; i < p.length && other_zeros; ++i)
-            other_zeros &= PolyIsZero(&p.monos[i].p);
-        if (first_zero && other_zeros) {
-            free(p.monos);
-            p.monos = NULL;
-            p.asCoef = 0;
-        } else if (other_zeros && p.monos[0].exp == 0 && PolyIsCoeff(&p.monos[0].p)) {
-            Poly nested = p.monos[0].p;
-            free(p.monos);
-            return nested;
-        }
-    }
-    return p;
-}
+    ///Moduł; 0 oznacza zwykłą arytmetykę <c>poly_coeff_t</c> (z przepełnieniami)
+    uint64_t modulus;
+
+    ///\f$ -\text{modulus}^{-1} \bmod R \f$
+    uint64_t inverse;
+
+    ///\f$ R^2 \bmod \text{modulus} \f$
+    uint64_t r_squared;
+} PolyModularArithmetic;
+
+///Arytmetyka współczynników ustawiona przez PolySetModulus() w bieżącym wątku
+static _Thread_local PolyModularArithmetic PolyModular = {0, 0, 0};
+
+///Czy współczynniki spoza zakresu <c>poly_coeff_t</c> są przechowywane dokładnie (PolySetExactCoefficients())
+static _Thread_local bool PolyExactCoefficients = false;
+
+///Czy bieżący wątek omija pamięć podręczną działań (PolySetCacheBypass())
+static _Thread_local bool PolyCacheBypass = false;
+
+///Największe liczby pierwsze mniejsze od \f$ 2^{62} \f$, modulo których PolyMulChecked() i PolyComposeChecked()
+///sprawdzają wynik
+static const uint64_t PolyCheckedPrimes[] = {
+        (UINT64_C(1) << 62) - 57, (UINT64_C(1) << 62) - 87, (UINT64_C(1) << 62) - 117, (UINT64_C(1) << 62) - 143,
+        (UINT64_C(1) << 62) - 153, (UINT64_C(1) << 62) - 167, (UINT64_C(1) << 62) - 171, (UINT64_C(1) << 62) - 195,
+};
 
 
 /**
- * Oblicz liczbę jednomianów w \f$ p + q \f$
- * @param p pierwszy sumy wielomian
- * @param q drugi wielomian sumy wielomian
- * @return liczbę jednomianów w wynikowym wielomianie \f$ p + q \f$
+ * Duży współczynnik: liczba całkowita dowolnej precyzji w zapisie znak-moduł.
+ * Duże współczynniki nie są zmieniane po utworzeniu, więc kopie wielomianów mogą je współdzielić.
  */
-static inline poly_exp_t CountSumLength(const Poly *p, const Poly *q)
+typedef struct
 {
-    assert(p->monos != NULL && q->monos != NULL);
+    ///Liczba wielomianów współdzielących ten współczynnik; nie jest atomowa, bo w trybie dokładnym algorytmy działają
+    ///na jednym wątku (PolyGetThreadCount())
+    uint32_t references;
 
-    poly_exp_t sum_length = 0;
-    poly_exp_t i = 0, j = 0;
+    ///Liczba cyfr
+    uint32_t size;
 
-    while (i < p->length && j < q->length) {
-        if (p->monos[i].exp < q->monos[j].exp) {
-            ++i;
-        } else if (p->monos[i].exp > q->monos[j].exp) {
-            ++j;
-        } else {
-            ++i, ++j;
-        }
-        ++sum_length;
-    }
+    ///Czy liczba jest ujemna
+    bool negative;
 
-    return sum_length + (p->length - i) + (q->length - j);
-}
+    ///Cyfry modułu liczby w systemie o podstawie \f$ 2^{64} \f$, od najmniej znaczącej
+    uint64_t limbs[];
+} BigCoeff;
 
 
 /**
- * Oblicz \f$ p + q \f$ zakładając, że tylko <c>q</c> jest współczynnikiem.
- * To jest podprzypadek dodawania wielomianów, kiedy jeden z nich jest wspołczynnikiem, a drug nie.
- * @param p wielomian niebędący współczynnikiem
- * @param q wielomian będący współvczynnikiem
- * @return wielomian \f$ p + q \f$
+ * Widok na cyfry współczynnika (dużego lub mieszczącego się w <c>poly_coeff_t</c>).
  */
-static inline Poly PolyAddPC(const Poly *p, const Poly *q)
+typedef struct
 {
-    assert(q->monos == NULL && p->monos != NULL);
-    if (q->asCoef == 0)
-        return PolyClone(p);
+    ///Cyfry modułu liczby, od najmniej znaczącej
+    const uint64_t *limbs;
 
-    Poly result;
-    if (p->monos[0].exp == 0) {
-        //Trzeba zsumować
-        result.length = p->length;
-        result.monos = malloc(sizeof(Mono) * result.length);
-        assert(result.monos != NULL);
-        result.monos[0] = (Mono){.p = PolyAdd(q, &p->monos[0].p), .exp = 0};
-        for (poly_exp_t i = 1; i < p->length; ++i)
-            result.monos[i] = MonoClone(p->monos + i);
-    } else {
-        //Nie sumujemy
-        result.length = p->length + 1;
-        result.monos = malloc(sizeof(Mono) * result.length);
-        assert(result.monos != NULL);
-        result.monos[0] = (Mono){.p = PolyClone(q), .exp = 0};
-        for (poly_exp_t i = 0; i < p->length; ++i)
-            result.monos[1 + i] = MonoClone(p->monos + i);
-    }
+    ///Liczba cyfr (bez wiodących zer)
+    uint32_t size;
 
-#ifdef WILL_RUN_ILL_TESTS
-    return PolySimplifyCoeff(result);
-#else
-    return result;
-#endif
-}
+    ///Czy liczba jest ujemna
+    bool negative;
+} CoeffDigits;
 
 
 /**
- * Oblicz \f$ p + q \f$ zakładając, że żąden z nich nie jest współczynnikiem.
- * To jest podprzypadek dodawania wielomianów, kiedy żaden z nich nie jest wspołczynnikiem.
- * @param p wielomian niebędący współczynnikiem
- * @param q wielomian niebędący współczynnikiem
- * @return wielomian \f$ p + q \f$
+ * Zadanie dla puli wątków: wywołanie <c>task(context, i)</c> dla każdego <c>i</c> z przedziału <c>[0, count)</c>.
  */
-static inline Poly PolyAddPP(const Poly *p, const Poly *q)
+typedef struct
 {
-    assert(p->monos != NULL);
-    assert(q->monos != NULL);
+    ///Funkcja wykonywana dla każdego indeksu
+    void (*task)(void *context, size_t index);
 
-    Poly result;
-    result.length = CountSumLength(p, q);
-    result.monos = malloc(sizeof(Mono) * result.length);
-    assert(result.monos != NULL);
+    ///Dane przekazywane funkcji <c>task</c>
+    void *context;
 
-    poly_exp_t p_index = 0, q_index = 0, result_index = 0;
-    while (p_index < p->length && q_index < q->length) {
-        if (p->monos[p_index].exp < q->monos[q_index].exp) {
-            result.monos[result_index] = MonoClone(p->monos + p_index);
-            ++p_index;
-        } else if (p->monos[p_index].exp > q->monos[q_index].exp) {
-            result.monos[result_index] = MonoClone(q->monos + q_index);
-            ++q_index;
-        } else {
-            result.monos[result_index] = (Mono){
-                .p = PolyAdd(&p->monos[p_index].p, &q->monos[q_index].p),
-                .exp = p->monos[p_index].exp
-            };
-            ++p_index;
-            ++q_index;
-        }
-        ++result_index;
-    }
+    ///Liczba indeksów do przetworzenia
+    size_t count;
 
-    for (; p_index < p->length; ++p_index)
-        result.monos[result_index++] = MonoClone(&p->monos[p_index]);
-    for (; q_index < q->length; ++q_index)
-        result.monos[result_index++] = MonoClone(&q->monos[q_index]);
+    ///Następny nieprzydzielony indeks
+    atomic_size_t next;
 
-    return PolySimplifyCoeff(result);
+    ///Arytmetyka współczynników wątku zlecającego, przejmowana przez wątki robocze
+    PolyModularArithmetic modular;
+
+    ///Tryb dokładny wątku zlecającego, przejmowany przez wątki robocze
+    bool exact;
+
+    ///Czy wątek zlecający omija pamięć podręczną działań; przejmowane przez wątki robocze
+    bool cache_bypass;
+} PolyParallelJob;
+
+
+void PolySetThreadCount(unsigned threads)
+{
+    atomic_store(&PolyThreadCount, threads);
 }
 
 
 /**
- * Ogonowa implementacja szybkiego potęgowania dla wykładników większych od 0.
- * @param base baza potęgi
- * @param exponent wykładnik
- * @param accumulator akumulator
- * @return \f$ \text{acccumulator} \cdot \text{base}^\text{exponent} \f$
+ * Zwraca liczbę wątków, na których mają działać równoległe algorytmy. W trybie dokładnym (PolySetExactCoefficients())
+ * jest to zawsze 1, bo liczniki referencji dużych współczynników nie są atomowe.
+ * @return liczba wątków, nie większa niż <c>POLY_MAX_THREADS</c>
  */
-static poly_coeff_t QuickPowerTail(poly_coeff_t base, poly_exp_t exponent, poly_coeff_t accumulator)
+static unsigned PolyGetThreadCount(void)
 {
-    if (exponent == 0)
-        return accumulator;
-    if (exponent % 2 == 0)
-        return QuickPowerTail(base * base, exponent / 2, accumulator);
-    return QuickPowerTail(base * base, exponent / 2, accumulator * base);
+    if (PolyExactCoefficients)
+        return 1;
+    long threads = atomic_load(&PolyThreadCount);
+    if (threads == 0)
+        threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1)
+        threads = 1;
+    return threads > POLY_MAX_THREADS ? POLY_MAX_THREADS : (unsigned)threads;
 }
 
 
 /**
- * Implementacja szybkiego potęgowania.
- * Ta funkcja wewnętrznie odwołuje się do QuickPowerTail(), po sprawdzeniu, czy <c>exponent >= 0</c>.
- * @param base baza potęgowania
- * @param exponent wykładnik
- * @return \f$ \text{base}^\text{exponent} \f$
+ * Tablica jednomianów poprzedzona nagłówkiem. Tablice są współdzielone przez kopie wielomianów (PolyClone()) i
+ * zwalniane, gdy zniknie ostatnie odwołanie; przed zmianą w miejscu tablicę trzeba odłączyć (PolyMakeUnique()).
  */
-static inline poly_coeff_t QuickPower(poly_coeff_t base, poly_exp_t exponent)
+typedef struct PolyPoolBlock
 {
-    assert(exponent >= 0);
-    return QuickPowerTail(base, exponent, 1);
-}
+    union
+    {
+        ///Następna wolna tablica tej samej klasy (gdy tablica jest wolna)
+        struct PolyPoolBlock *next;
 
+        ///Nagłówek używanej tablicy
+        struct
+        {
+            ///Klasa rozmiaru, czyli pojemność tablicy; 0 dla tablic spoza puli
+            uint32_t size_class : 31;
 
-void PolyScaleInplace(Poly *p, poly_coeff_t scalar)
-{
-    if (scalar == 0) {
-        free(p->monos);
-        p->monos = NULL;
-        p->asCoef = 0;
-    } else if (PolyIsCoeff(p)) {
-        p->asCoef *= scalar;
-    } else {
-        for (poly_exp_t i = 0; i < p->length; ++i)
-            PolyScaleInplace(&p->monos[i].p, scalar);
-    }
-}
+            ///Czy tablica jest w tablicy internowania (PolyIntern()); takiej tablicy nie wolno zmieniać w miejscu
+            uint32_t interned : 1;
+
+            ///Liczba wielomianów, które mają tę tablicę
+            atomic_uint references;
+        };
+    };
+
+    ///Jednomiany
+    Mono monos[];
+} PolyPoolBlock;
 
 
 /**
- * Zwraca wielomian-nie-współczynnik pomnożony przez jednomian.
- * @param p wielomian; nie może być współczynnikiem
- * @param q jednomian
- * @return \f$ q * q \f$
+ * Zwraca nagłówek tablicy jednomianów przydzielonej przez MonosAlloc().
+ * @param monos tablica
+ * @return nagłówek
  */
-static Poly PolyMulM(const Poly *p, const Mono *q)
+static inline PolyPoolBlock *PolyPoolHeader(Mono *monos)
 {
-    assert(p->monos != NULL);
-    if (PolyIsZero(&q->p))
-        return PolyZero();
+    return (PolyPoolBlock *)((char *)monos - offsetof(PolyPoolBlock, monos));
+}
 
-    Poly result;
-    result.length = p->length;
-    result.monos = malloc(sizeof(Mono) * result.length);
-    assert(result.monos != NULL);
 
-    //Trzeba ,,rozpakować'' wielomian p, bo inaczej zmniejszami indeksy zmiennych w q, a nie w p
-    //i dzieją się dziwne rzeczy
-    for (poly_exp_t i = 0; i < p->length; ++i) {
-        result.monos[i].exp = q->exp + p->monos[i].exp;
-        result.monos[i].p = PolyMul(&p->monos[i].p, &q->p);
-    }
+#ifndef POLY_USE_MALLOC
 
-#ifdef WILL_RUN_ILL_TESTS
-    return PolySimplifyCoeff(result);
-#else
-    return result;
-#endif
-}
+///Listy wolnych tablic bieżącego wątku, osobno dla każdej klasy rozmiaru
+static _Thread_local PolyPoolBlock *PolyPoolFree[POLY_POOL_MAX_LENGTH];
+
+///Wolne tablice oddane przez wątki robocze po wykonaniu zadania
+static PolyPoolBlock *PolyPoolShared[POLY_POOL_MAX_LENGTH];
+
+///Chroni <c>PolyPoolShared</c>
+static pthread_mutex_t PolyPoolMutex = PTHREAD_MUTEX_INITIALIZER;
 
 
 /**
- * Scal dwie tablice posortowanych jednomianów do w tablicy wynikowej.
- * Metoda zakłada, że <c>in1</c> jest na w swapowanej tablicy, a <c>in2</c> to sufiks tablicy <c>out</c>. Wynik scalenia
- * umieszczony będzie w tablicy <c>out</c>, a tablica <c>in1</c> zostanie nietknięta. Jednomiany o tym samym wykładniku
- * nie są scalane.
- * @param in1 pierwsza z posortowanych tablic; rozłączna z <c>out</c>
- * @param in2  druga z posortowanych tablic; sufiks tablicy <c>out</c>
- * @param out tablica, w której zostanie zapisany wynik
- * @param len1 długość tablicy <c>in1</c>
- * @param len2 długość tablicy <c>in2</c>
+ * Blok pamięci areny.
  */
-static void PolyMergeSortedMonos(Mono *in1, Mono *in2, Mono *out, int len1, int len2)
+typedef struct PolyArenaChunk
 {
-    poly_exp_t i = 0, j1 = 0, j2 = 0;
-    while (j1 < len1 && j2 < len2) {
-        Mono m;
-        if (in1[j1].exp < in2[j2].exp) {
-            m = in1[j1];
-            ++j1;
-        } else {
-            //Może być więcej niż dwa o równym stopniu, więc nie ma sensu teraz zajmować się równością stopni
-            m = in2[j2];
-            ++j2;
-        }
-        out[i++] = m;
-    }
+    ///Następny blok; bloki nie są zwalniane przy czyszczeniu areny, tylko używane ponownie
+    struct PolyArenaChunk *next;
 
-    if (j1 < len1)
-        memcpy(out + i, in1 + j1, (len1 - j1) * sizeof(Mono));
-    //Zgodnie z założeniami, jeśli in2 się nie skończyło, to i tak jest już na swoim miejscu
-}
+    ///Miejsce na tablice jednomianów
+    char data[];
+} PolyArenaChunk;
 
 
 /**
- * Sortuje tablicę jednomianów niemalejąco według ich wykładnika.
- * Jednomiany o tych samych wykładnikach nie są scalane.
- * @param monos tablica jednomianów do posortowania
- * @param length długość tablicy <c>monos</c>
+ * Stan areny wątku.
  */
-static void PolySortMonos(Mono *monos, poly_exp_t length)
+typedef struct
 {
-    if (length == 1)
-        return;
+    ///Czy krótkie tablice jednomianów są wydzielane z areny (pomiędzy PolyArenaBegin() a PolyArenaEnd())
+    bool active;
 
-    poly_exp_t len1 = length / 2;
-    poly_exp_t len2 = length - len1;
-    Mono *sub1 = malloc(sizeof(Mono) * len1);
-    assert(sub1 != NULL);
-    Mono *sub2 = monos + len1;
+    ///Pierwszy blok areny
+    PolyArenaChunk *first;
 
-    memcpy(sub1, monos, sizeof(Mono) * len1);
-    PolySortMonos(sub1, len1);
-    PolySortMonos(monos + len1, len2);
+    ///Blok, z którego wydzielamy tablice; <c>NULL</c>, gdy arena jest pusta
+    PolyArenaChunk *current;
 
-    PolyMergeSortedMonos(sub1, sub2, monos, len1, len2);
-    free(sub1);
-}
+    ///Liczba zajętych bajtów bloku <c>current</c>
+    size_t used;
+
+    ///Liczba bloków areny
+    size_t chunks;
+} PolyArenaState;
+
+///Arena bieżącego wątku
+static _Thread_local PolyArenaState PolyArena;
 
 
 /**
- * Tworzy wielomian zbudowany z sumy jednomianów podanych w tablicy.
- * Wielomian przejmuje na własność tablicę jednomianów i staje się ona jego wewnętrzną tablicą. W związku z tym, tablica
- * nowego wielomianu będzie za duża, kiedy w wejściowej tablicy <c>monos</c> będą jednomiany o takim samym wykładniku.
- * Te nadmiarowe jednomiany będą znajdować się na końcu tablicy. Pole <c>length</c> struktury wielomianu będzie
- * zawierało liczbę tylko prawidłowych jednomianów w tablicy, więc może być mniejsza niż wejściowa długość tablicy
- * jednomianów.
- * @param monos tablica jednomianów (przejmowana na własność)
- * @param length długosć tablicy <c>monos</c>
- * @return
+ * Oddaje wolne tablice bieżącego wątku na wspólne listy, żeby mogły je przejąć inne wątki.
  */
-static Poly PolyFromMonos(Mono *monos, poly_exp_t length)
+static void PolyPoolFlush(void)
 {
-    PolySortMonos(monos, length);
-
-    int i = 0;
-    for (int j = 1; j < length; ++j) {
-        if (monos[i].exp == monos[j].exp) {
-            Poly p = PolyAdd(&monos[i].p, &monos[j].p);
-            PolyDestroy(&monos[i].p);
-            PolyDestroy(&monos[j].p);
-            monos[i].p = p;
-        } else {
-            ++i;
-            monos[i] = monos[j];
-        }
+    for (size_t i = 0; i < POLY_POOL_MAX_LENGTH; ++i) {
+        PolyPoolBlock *head = PolyPoolFree[i];
+        if (head == NULL)
+            continue;
+        PolyPoolBlock *tail = head;
+        while (tail->next != NULL)
+            tail = tail->next;
+        pthread_mutex_lock(&PolyPoolMutex);
+        tail->next = PolyPoolShared[i];
+        PolyPoolShared[i] = head;
+        pthread_mutex_unlock(&PolyPoolMutex);
+        PolyPoolFree[i] = NULL;
     }
-
-    Poly p;
-    p.monos = monos;
-    p.length = i + 1;
-    return PolySimplifyCoeff(p);
 }
 
 
-void PolyDestroy(Poly *p)
+///Klucz, którego destruktor porządkuje pulę i arenę kończącego się wątku (PolyPoolThreadExit())
+static pthread_key_t PolyPoolThreadKey;
+
+///Zapewnia jednokrotne utworzenie <c>PolyPoolThreadKey</c>
+static pthread_once_t PolyPoolThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+///Czy bieżący wątek ustawił już wartość <c>PolyPoolThreadKey</c>
+static _Thread_local bool PolyPoolThreadRegistered = false;
+
+
+/**
+ * Destruktor <c>PolyPoolThreadKey</c>: oddaje wolne tablice kończącego się wątku na wspólne listy i zwalnia bloki
+ * jego areny, żeby wątki użytkownika, które kiedyś liczyły na wielomianach, nie zostawiały po sobie pamięci.
+ * @param value nieużywana wartość klucza
+ */
+static void PolyPoolThreadExit(void *value)
 {
-    if (p->monos != NULL) {
-        for (poly_exp_t i = 0; i < p->length; ++i)
-            MonoDestroy(p->monos + i);
-        free(p->monos);
+    (void)value;
+    PolyPoolFlush();
+    assert(!PolyArena.active);
+    while (PolyArena.first != NULL) {
+        PolyArenaChunk *next = PolyArena.first->next;
+        (free)(PolyArena.first);
+        PolyArena.first = next;
     }
+    PolyArena = (PolyArenaState){.active = false};
 }
 
 
-Poly PolyAdd(const Poly *p, const Poly *q)
+/**
+ * Tworzy <c>PolyPoolThreadKey</c>.
+ */
+static void PolyPoolThreadKeyCreate(void)
 {
-    if (p->monos == NULL && q->monos == NULL) {
-        Poly result;
-        result.monos = NULL;
-        result.asCoef = p->asCoef + q->asCoef;
-        return result;
-    }
+    int error = pthread_key_create(&PolyPoolThreadKey, PolyPoolThreadExit);
+    assert(error == 0);
+    (void)error;
+}
 
-    if (q->monos == NULL)
-        return PolyAddPC(p, q);
-    if (p->monos == NULL)
-        return PolyAddPC(q, p);
-    return PolyAddPP(p, q);
+
+/**
+ * Zapewnia, że wolne tablice i arena bieżącego wątku zostaną uporządkowane przy jego zakończeniu. Wywoływana, gdy
+ * wątek dostaje pierwsze tablice na własne listy albo pierwszy blok areny.
+ */
+static inline void PolyPoolRegisterThread(void)
+{
+    if (PolyPoolThreadRegistered)
+        return;
+    pthread_once(&PolyPoolThreadKeyOnce, PolyPoolThreadKeyCreate);
+    pthread_setspecific(PolyPoolThreadKey, &PolyPoolThreadKey);
+    PolyPoolThreadRegistered = true;
 }
 
 
-Poly PolyMul(const Poly *p, const Poly *q)
+/**
+ * Uzupełnia pustą listę wolnych tablic bieżącego wątku: przejmuje całą wspólną listę klasy, a gdy ta jest pusta,
+ * dzieli na tablice nowy blok o rozmiarze <c>POLY_POOL_CHUNK_BYTES</c>. Bloki nie są zwracane systemowi.
+ * @param size_class klasa rozmiaru
+ * @return niepusta lista wolnych tablic
+ */
+static PolyPoolBlock *PolyPoolRefill(size_t size_class)
 {
-    if (PolyIsCoeff(q)) {
-        Poly result = PolyClone(p);
-        PolyScaleInplace(&result, q->asCoef);
-#ifdef WILL_RUN_ILL_TESTS
-        return PolySimplifyCoeff(result);
-#else
-        return result;
+    PolyPoolRegisterThread();
+    pthread_mutex_lock(&PolyPoolMutex);
+    PolyPoolBlock *shared = PolyPoolShared[size_class - 1];
+    PolyPoolShared[size_class - 1] = NULL;
+    pthread_mutex_unlock(&PolyPoolMutex);
+    if (shared != NULL)
+        return shared;
+
+    size_t block_size = sizeof(PolyPoolBlock) + sizeof(Mono) * size_class;
+    size_t count = POLY_POOL_CHUNK_BYTES / block_size;
+    //Nawiasy omijają atrapę malloc z testów jednostkowych: bloki puli nie są zwalniane, a CMocka uznałaby je za wyciek
+    char *chunk = (malloc)(block_size * count);
+    assert(chunk != NULL);
+    for (size_t i = 0; i + 1 < count; ++i)
+        ((PolyPoolBlock *)(chunk + i * block_size))->next = (PolyPoolBlock *)(chunk + (i + 1) * block_size);
+    ((PolyPoolBlock *)(chunk + (count - 1) * block_size))->next = NULL;
+    return (PolyPoolBlock *)chunk;
+}
+
+
+/**
+ * Wydziela tablicę jednomianów z areny bieżącego wątku.
+ * @param length liczba jednomianów, nie większa niż <c>POLY_POOL_MAX_LENGTH</c>
+ * @return tablica z nagłówkiem albo <c>NULL</c>, gdy arena ma już <c>POLY_ARENA_MAX_CHUNKS</c> pełnych bloków
+ */
+static PolyPoolBlock *PolyArenaAlloc(size_t length)
+{
+    size_t size = sizeof(PolyPoolBlock) + sizeof(Mono) * length;
+    if (PolyArena.current == NULL || PolyArena.used + size > POLY_ARENA_CHUNK_BYTES) {
+        PolyArenaChunk **next = PolyArena.current == NULL ? &PolyArena.first : &PolyArena.current->next;
+        if (*next == NULL) {
+            if (PolyArena.chunks == POLY_ARENA_MAX_CHUNKS)
+                return NULL;
+            //Bloki areny, tak jak bloki puli, omijają atrapę malloc z testów jednostkowych
+            *next = (malloc)(sizeof(PolyArenaChunk) + POLY_ARENA_CHUNK_BYTES);
+            assert(*next != NULL);
+            PolyPoolRegisterThread();
+            (*next)->next = NULL;
+            ++PolyArena.chunks;
+        }
+        PolyArena.current = *next;
+        PolyArena.used = 0;
+    }
+    PolyPoolBlock *block = (PolyPoolBlock *)(PolyArena.current->data + PolyArena.used);
+    PolyArena.used += size;
+    block->size_class = POLY_ARENA_SIZE_CLASS;
+    return block;
+}
+#endif
+
+
+/**
+ * Przydziela tablicę jednomianów, którą może przejąć wielomian (zwalnianą przez MonosFree()), z jednym odwołaniem.
+ * Krótkie tablice pochodzą z listy wolnych tablic swojej klasy rozmiaru w bieżącym wątku, dłuższe z <c>malloc</c>.
+ * @param length liczba jednomianów
+ * @return niezainicjowana tablica
+ */
+static Mono *MonosAlloc(size_t length)
+{
+    PolyPoolBlock *block;
+#ifndef POLY_USE_MALLOC
+    if (length != 0 && length <= POLY_POOL_MAX_LENGTH) {
+        if (!PolyArena.active || (block = PolyArenaAlloc(length)) == NULL) {
+            block = PolyPoolFree[length - 1];
+            if (block == NULL)
+                block = PolyPoolRefill(length);
+            PolyPoolFree[length - 1] = block->next;
+            block->size_class = (uint32_t)length;
+        }
+        block->interned = false;
+        atomic_store_explicit(&block->references, 1, memory_order_relaxed);
+        return block->monos;
+    }
+#endif
+    block = malloc(sizeof(PolyPoolBlock) + sizeof(Mono) * length);
+    assert(block != NULL);
+    block->size_class = 0;
+    block->interned = false;
+    atomic_store_explicit(&block->references, 1, memory_order_relaxed);
+    return block->monos;
+}
+
+
+/**
+ * Zwalnia tablicę jednomianów przydzieloną przez MonosAlloc(); tablica z puli trafia na listę wolnych tablic
+ * bieżącego wątku.
+ * @param monos tablica
+ */
+static inline void MonosFree(Mono *monos)
+{
+    PolyPoolBlock *block = PolyPoolHeader(monos);
+    uint32_t size_class = block->size_class;
+    if (size_class == 0) {
+        free(block);
+    } else if (size_class != POLY_ARENA_SIZE_CLASS) {
+#ifndef POLY_USE_MALLOC
+        if (PolyPoolFree[size_class - 1] == NULL)
+            PolyPoolRegisterThread();
+        block->next = PolyPoolFree[size_class - 1];
+        PolyPoolFree[size_class - 1] = block;
 #endif
     }
-    //W innek kolenjości się zapętli
+}
+
+
+/**
+ * Usuwa jedno odwołanie do tablicy jednomianów.
+ * Jedyny właściciel nie potrzebuje operacji atomowej: nikt inny nie może wtedy dodać odwołania. Statyczne tablice
+ * (PolyShareSmallTerm()) nigdy nie są zwalniane.
+ * @param monos tablica
+ * @return czy było to ostatnie odwołanie (wtedy trzeba usunąć jednomiany i zwolnić tablicę)
+ */
+static inline bool MonosRelease(Mono *monos)
+{
+    if (PolyPoolHeader(monos)->size_class == POLY_STATIC_SIZE_CLASS)
+        return false;
+    atomic_uint *references = &PolyPoolHeader(monos)->references;
+    return atomic_load_explicit(references, memory_order_acquire) == 1
+           || atomic_fetch_sub_explicit(references, 1, memory_order_acq_rel) == 1;
+}
+
+
+/**
+ * Tworzy nową tablicę z jednomianami wielomianu; jednomiany kopii współdzielą współczynniki z oryginałem.
+ * @param p wielomian niebędący współczynnikiem
+ * @return tablica z jednym odwołaniem
+ */
+static Mono *MonosCopy(const Poly *p)
+{
+    Mono *monos = MonosAlloc((size_t)p->length);
+    for (poly_exp_t i = 0; i < p->length; ++i)
+        monos[i] = MonoClone(&p->monos[i]);
+    return monos;
+}
+
+
+///Rozmiar statycznej tablicy jednego jednomianu wraz z nagłówkiem
+#define POLY_SMALL_TERM_BYTES (sizeof(PolyPoolBlock) + sizeof(Mono))
+
+///Wspólne tablice jednomianów \f$ c x^e \f$ o małych <c>c != 0</c> i <c>e</c>, indeksowane przez
+///<c>[c + POLY_SMALL_TERM_MAX_COEFF - (c > 0)][e]</c>
+static _Alignas(PolyPoolBlock)
+char PolySmallTerms[2 * POLY_SMALL_TERM_MAX_COEFF][POLY_SMALL_TERM_MAX_EXP + 1][POLY_SMALL_TERM_BYTES];
+
+///Wypełnia <c>PolySmallTerms</c> dokładnie raz
+static pthread_once_t PolySmallTermsOnce = PTHREAD_ONCE_INIT;
+
+
+/**
+ * Wypełnia wspólne tablice jednomianów. Licznik odwołań ustawiony na stałe na 2 sprawia, że PolyMakeUnique()
+ * zawsze kopiuje taką tablicę przed zmianą.
+ */
+static void PolySmallTermsInit(void)
+{
+    for (int c = -POLY_SMALL_TERM_MAX_COEFF; c <= POLY_SMALL_TERM_MAX_COEFF; ++c) {
+        for (poly_exp_t e = 0; c != 0 && e <= POLY_SMALL_TERM_MAX_EXP; ++e) {
+            PolyPoolBlock *block = (PolyPoolBlock *)PolySmallTerms[c + POLY_SMALL_TERM_MAX_COEFF - (c > 0)][e];
+            block->size_class = POLY_STATIC_SIZE_CLASS;
+            block->interned = false;
+            atomic_init(&block->references, 2);
+            block->monos[0] = (Mono){.p = PolyFromCoeff(c), .exp = e};
+        }
+    }
+}
+
+
+/**
+ * Zamienia tablicę jednomianu \f$ c x^e \f$ o małych <c>c</c> i <c>e</c> na wspólną, statyczną tablicę, dzięki
+ * czemu takie wielomiany (częste jako współczynniki zagnieżdżone) nie zajmują własnej pamięci. Tablice internowane
+ * zostają na miejscu.
+ * @param p wielomian niebędący współczynnikiem, przejmowany na własność
+ * @return wielomian równy <c>p</c>
+ */
+static Poly PolyShareSmallTerm(Poly p)
+{
+    const Mono *m = p.monos;
+    if (p.length != 1 || !PolyIsSmallCoeff(&m->p) || m->exp > POLY_SMALL_TERM_MAX_EXP
+        || m->p.asCoef < -POLY_SMALL_TERM_MAX_COEFF || m->p.asCoef > POLY_SMALL_TERM_MAX_COEFF || m->p.asCoef == 0)
+        return p;
+    PolyPoolBlock *block = PolyPoolHeader(p.monos);
+    if (block->interned || block->size_class == POLY_STATIC_SIZE_CLASS)
+        return p;
+
+    pthread_once(&PolySmallTermsOnce, PolySmallTermsInit);
+    poly_coeff_t c = m->p.asCoef;
+    Mono *shared = ((PolyPoolBlock *)PolySmallTerms[c + POLY_SMALL_TERM_MAX_COEFF - (c > 0)][m->exp])->monos;
+    PolyDestroy(&p);
+    p.monos = shared;
+    return p;
+}
+
+
+/**
+ * Odłącza tablicę jednomianów wielomianu od innych wielomianów, które ją współdzielą (także od tablicy
+ * internowania), żeby można ją było zmienić w miejscu. Kopiowana jest tylko ta tablica; współczynniki jednomianów
+ * pozostają współdzielone.
+ * @param p wielomian niebędący współczynnikiem
+ */
+static void PolyMakeUnique(Poly *p)
+{
+    PolyPoolBlock *block = PolyPoolHeader(p->monos);
+    if (!block->interned && atomic_load_explicit(&block->references, memory_order_acquire) == 1)
+        return;
+    Mono *monos = MonosCopy(p);
+    PolyDestroy(p);
+    p->monos = monos;
+}
+
+
+#ifndef POLY_USE_MALLOC
+/**
+ * Przenosi do puli tablice jednomianów wielomianu, które pochodzą z areny; pozostałe tablice zostają na miejscu.
+ * @param p wielomian
+ */
+static void PolyArenaPromote(Poly *p)
+{
     if (PolyIsCoeff(p))
-        return PolyMul(q, p); //Także nie należy zapominać, że C nie jest funkcyjny: trzeba pisać return...
+        return;
+    for (poly_exp_t i = 0; i < p->length; ++i)
+        PolyArenaPromote(&p->monos[i].p);
+    if (PolyPoolHeader(p->monos)->size_class == POLY_ARENA_SIZE_CLASS) {
+        Mono *monos = MonosCopy(p);
+        PolyDestroy(p);
+        p->monos = monos;
+    }
+}
+#endif
 
-    Poly fold = PolyZero();
-    for (poly_exp_t i = 0; i < q->length; ++i) {
-        if (PolyIsZero(&q->monos[i].p))
-            continue;
-        Poly old_fold = fold;
-        Poly next = PolyMulM(p, q->monos + i);
-        fold = PolyAdd(&old_fold, &next);
-        PolyDestroy(&old_fold);
-        PolyDestroy(&next);
+
+void PolyArenaBegin(void)
+{
+#ifndef POLY_USE_MALLOC
+    assert(!PolyArena.active);
+    PolyArena.active = true;
+#endif
+}
+
+
+void PolyArenaEnd(Poly *result)
+{
+#ifndef POLY_USE_MALLOC
+    assert(PolyArena.active);
+    PolyArena.active = false;
+    if (result != NULL)
+        PolyArenaPromote(result);
+    PolyArena.current = NULL;
+    PolyArena.used = 0;
+#else
+    (void)result;
+#endif
+}
+
+
+/**
+ * Pętla wątku roboczego: przejmuje arytmetykę współczynników wątku zlecającego i pobiera kolejne indeksy zadania,
+ * aż się skończą.
+ * @param arg wskaźnik na <c>PolyParallelJob</c>
+ * @return <c>NULL</c>
+ */
+static void *PolyParallelWorker(void *arg)
+{
+    PolyParallelJob *job = arg;
+    PolyModular = job->modular;
+    PolyExactCoefficients = job->exact;
+    PolyCacheBypass = job->cache_bypass;
+    size_t index;
+    while ((index = atomic_fetch_add(&job->next, 1)) < job->count)
+        job->task(job->context, index);
+    return NULL;
+}
+
+
+/**
+ * Stała pula wątków roboczych PolyParallelFor(). Wątki są tworzone przy pierwszej potrzebie, a potem czekają na
+ * kolejne zadania; w danej chwili pula wykonuje co najwyżej jedno zadanie.
+ */
+typedef struct
+{
+    ///Chroni pozostałe pola
+    pthread_mutex_t mutex;
+
+    ///Sygnalizowana, gdy w zadaniu zwolniły się miejsca dla wątków roboczych
+    pthread_cond_t wake;
+
+    ///Sygnalizowana, gdy ostatni wątek roboczy zakończył swoją część zadania
+    pthread_cond_t done;
+
+    ///Bieżące zadanie
+    PolyParallelJob *job;
+
+    ///Liczba utworzonych wątków roboczych
+    unsigned workers;
+
+    ///Liczba wątków roboczych, które mogą jeszcze dołączyć do bieżącego zadania
+    unsigned slots;
+
+    ///Liczba wątków roboczych, które dołączyły lub dołączą do bieżącego zadania i jeszcze go nie skończyły
+    unsigned active;
+
+    ///Czy pula wykonuje zadanie
+    bool busy;
+} PolyWorkerPool;
+
+///Pula wątków roboczych
+static PolyWorkerPool PolyWorkers = {
+        .mutex = PTHREAD_MUTEX_INITIALIZER,
+        .wake = PTHREAD_COND_INITIALIZER,
+        .done = PTHREAD_COND_INITIALIZER,
+};
+
+
+/**
+ * Funkcja wątku z puli: czeka na wolne miejsce w zadaniu, wykonuje je i oddaje wolne tablice wątku do puli tablic.
+ * Wątki z puli nie kończą się.
+ * @param arg nieużywany
+ * @return nigdy nie wraca
+ */
+static void *PolyWorkerThread(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&PolyWorkers.mutex);
+    for (;;) {
+        while (PolyWorkers.slots == 0)
+            pthread_cond_wait(&PolyWorkers.wake, &PolyWorkers.mutex);
+        --PolyWorkers.slots;
+        PolyParallelJob *job = PolyWorkers.job;
+        pthread_mutex_unlock(&PolyWorkers.mutex);
+
+        PolyParallelWorker(job);
+#ifndef POLY_USE_MALLOC
+        PolyPoolFlush();
+#endif
+
+        pthread_mutex_lock(&PolyWorkers.mutex);
+        if (--PolyWorkers.active == 0)
+            pthread_cond_signal(&PolyWorkers.done);
+    }
+    return NULL;
+}
+
+
+/**
+ * Wywołuje <c>task(context, i)</c> dla wszystkich <c>i < count</c>, rozdzielając indeksy pomiędzy wątki z puli.
+ * Wątek wywołujący też bierze udział w obliczeniach. Gdy pula jest zajęta (wywołanie zagnieżdżone w zadaniu albo
+ * równoległe wywołanie z innego wątku) lub nie da się utworzyć wątku, praca jest wykonywana przez wątki, które są
+ * dostępne, w ostateczności tylko przez wątek wywołujący.
+ * @param count liczba indeksów
+ * @param task funkcja wywoływana dla każdego indeksu; wywołania dla różnych indeksów muszą być niezależne
+ * @param context dane dla funkcji <c>task</c>
+ */
+static void PolyParallelFor(size_t count, void (*task)(void *, size_t), void *context)
+{
+    unsigned threads = PolyGetThreadCount();
+    if (threads > count)
+        threads = (unsigned)count;
+
+    PolyParallelJob job = {
+            .task = task,
+            .context = context,
+            .count = count,
+            .modular = PolyModular,
+            .exact = PolyExactCoefficients,
+            .cache_bypass = PolyCacheBypass,
+    };
+    atomic_init(&job.next, 0);
+    if (threads <= 1) {
+        PolyParallelWorker(&job);
+        return;
+    }
+
+    pthread_mutex_lock(&PolyWorkers.mutex);
+    if (PolyWorkers.busy) {
+        pthread_mutex_unlock(&PolyWorkers.mutex);
+        PolyParallelWorker(&job);
+        return;
+    }
+    PolyWorkers.busy = true;
+    pthread_t thread;
+    while (PolyWorkers.workers + 1 < threads && pthread_create(&thread, NULL, PolyWorkerThread, NULL) == 0) {
+        pthread_detach(thread);
+        ++PolyWorkers.workers;
+    }
+    unsigned helpers = threads - 1 < PolyWorkers.workers ? threads - 1 : PolyWorkers.workers;
+    PolyWorkers.job = &job;
+    PolyWorkers.slots = helpers;
+    PolyWorkers.active = helpers;
+    pthread_cond_broadcast(&PolyWorkers.wake);
+    pthread_mutex_unlock(&PolyWorkers.mutex);
+
+    PolyParallelWorker(&job);
+
+    pthread_mutex_lock(&PolyWorkers.mutex);
+    while (PolyWorkers.active > 0)
+        pthread_cond_wait(&PolyWorkers.done, &PolyWorkers.mutex);
+    PolyWorkers.job = NULL;
+    PolyWorkers.busy = false;
+    pthread_mutex_unlock(&PolyWorkers.mutex);
+}
+
+
+/**
+ * Redukcja Montgomery'ego: wylicza \f$ t R^{-1} \bmod \text{modulus} \f$.
+ * @param t liczba mniejsza od \f$ \text{modulus} \cdot R \f$
+ * @return \f$ t R^{-1} \bmod \text{modulus} \f$
+ */
+static inline uint64_t MontgomeryReduce(unsigned __int128 t)
+{
+    uint64_t m = (uint64_t)t * PolyModular.inverse;
+    uint64_t result = (uint64_t)((t + (unsigned __int128)m * PolyModular.modulus) >> 64);
+    return result >= PolyModular.modulus ? result - PolyModular.modulus : result;
+}
+
+
+/**
+ * Sprowadza współczynnik do przedziału \f$ [0, \text{modulus}) \f$; bez modułu zwraca go bez zmian.
+ * @param c współczynnik
+ * @return zredukowany współczynnik
+ */
+static inline poly_coeff_t CoeffReduce(poly_coeff_t c)
+{
+    if (PolyModular.modulus == 0)
+        return c;
+    poly_coeff_t result = c % (poly_coeff_t)PolyModular.modulus;
+    return result < 0 ? result + (poly_coeff_t)PolyModular.modulus : result;
+}
+
+
+/**
+ * Dodaje współczynniki w bieżącej arytmetyce.
+ * @param a zredukowany składnik
+ * @param b zredukowany składnik
+ * @return \f$ a + b \f$
+ */
+static inline poly_coeff_t CoeffAdd(poly_coeff_t a, poly_coeff_t b)
+{
+    if (PolyModular.modulus == 0)
+        return a + b;
+    uint64_t result = (uint64_t)a + (uint64_t)b;
+    return (poly_coeff_t)(result >= PolyModular.modulus ? result - PolyModular.modulus : result);
+}
+
+
+/**
+ * Mnoży współczynniki w bieżącej arytmetyce.
+ * Współczynniki nie są trzymane w postaci Montgomery'ego, więc iloczyn jest redukowany dwa razy: druga redukcja
+ * mnoży przez \f$ R^2 \f$ i znosi czynnik \f$ R^{-1} \f$ pierwszej. To wciąż tylko mnożenia, bez dzielenia.
+ * @param a zredukowany czynnik
+ * @param b zredukowany czynnik
+ * @return \f$ ab \f$
+ */
+static inline poly_coeff_t CoeffMul(poly_coeff_t a, poly_coeff_t b)
+{
+    if (PolyModular.modulus == 0)
+        return a * b;
+    uint64_t reduced = MontgomeryReduce((unsigned __int128)(uint64_t)a * (uint64_t)b);
+    return (poly_coeff_t)MontgomeryReduce((unsigned __int128)reduced * PolyModular.r_squared);
+}
+
+
+/**
+ * Neguje współczynnik w bieżącej arytmetyce.
+ * @param a zredukowany współczynnik
+ * @return \f$ -a \f$
+ */
+static inline poly_coeff_t CoeffNeg(poly_coeff_t a)
+{
+    if (PolyModular.modulus == 0)
+        return -a;
+    return a == 0 ? 0 : (poly_coeff_t)PolyModular.modulus - a;
+}
+
+
+/**
+ * Potęguje liczbę modulo dowolny moduł (używane tylko przy sprawdzaniu pierwszości modułu).
+ * @param base podstawa mniejsza od modułu
+ * @param exponent wykładnik
+ * @param modulus moduł
+ * @return \f$ \text{base}^\text{exponent} \bmod \text{modulus} \f$
+ */
+static uint64_t ModularPower(uint64_t base, uint64_t exponent, uint64_t modulus)
+{
+    uint64_t result = 1;
+    for (; exponent > 0; exponent /= 2, base = (uint64_t)((unsigned __int128)base * base % modulus)) {
+        if (exponent % 2 == 1)
+            result = (uint64_t)((unsigned __int128)result * base % modulus);
+    }
+    return result;
+}
+
+
+/**
+ * Deterministyczny test Millera-Rabina; świadkowie będący 12 pierwszymi liczbami pierwszymi wystarczają dla
+ * wszystkich liczb 64-bitowych.
+ * @param n sprawdzana liczba
+ * @return czy <c>n</c> jest liczbą pierwszą
+ */
+static bool IsPrime(uint64_t n)
+{
+    static const uint64_t witnesses[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    const size_t count = sizeof(witnesses) / sizeof(witnesses[0]);
+    if (n < 2)
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (n % witnesses[i] == 0)
+            return n == witnesses[i];
+    }
+
+    uint64_t d = n - 1;
+    unsigned s = 0;
+    for (; d % 2 == 0; d /= 2)
+        ++s;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t x = ModularPower(witnesses[i], d, n);
+        for (unsigned r = 1; r < s && x != 1 && x != n - 1; ++r)
+            x = (uint64_t)((unsigned __int128)x * x % n);
+        if (x != 1 && x != n - 1)
+            return false;
+    }
+    return true;
+}
+
+
+bool PolyIsValidModulus(poly_coeff_t modulus)
+{
+    return modulus == 0
+           || (modulus > 2 && (uint64_t)modulus < (UINT64_C(1) << POLY_MODULUS_BITS) && IsPrime((uint64_t)modulus));
+}
+
+
+void PolySetModulus(poly_coeff_t modulus)
+{
+    assert(PolyIsValidModulus(modulus));
+    PolyModularArithmetic modular = {.modulus = (uint64_t)modulus, .inverse = 0, .r_squared = 0};
+    if (modulus != 0) {
+        //Metoda Newtona: dla nieparzystego n zachodzi n * n = 1 (mod 8), a każdy krok podwaja liczbę dobrych bitów
+        uint64_t inverse = modular.modulus;
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - modular.modulus * inverse;
+        modular.inverse = -inverse;
+        uint64_t r = (uint64_t)(((unsigned __int128)1 << 64) % modular.modulus);
+        modular.r_squared = (uint64_t)((unsigned __int128)r * r % modular.modulus);
+    }
+    PolyModular = modular;
+}
+
+
+poly_coeff_t PolyGetModulus(void)
+{
+    return (poly_coeff_t)PolyModular.modulus;
+}
+
+
+void PolySetExactCoefficients(bool exact)
+{
+    PolyExactCoefficients = exact;
+}
+
+
+/**
+ * Sprawdza, czy współczynniki mogą wyjść poza <c>poly_coeff_t</c> (tryb dokładny bez modułu). Wtedy ścieżki
+ * liczące na surowych wartościach <c>poly_coeff_t</c> nie mogą być używane.
+ * @return czy wyniki działań na współczynnikach mogą być dużymi liczbami
+ */
+static inline bool CoeffMaySpill(void)
+{
+    return PolyExactCoefficients && PolyModular.modulus == 0;
+}
+
+
+/**
+ * Sprawdza, czy wielomian jest dużym współczynnikiem (przechowywanym w tablicy cyfr).
+ * @param p wielomian
+ * @return czy <c>p</c> jest dużym współczynnikiem
+ */
+static inline bool PolyIsBigCoeff(const Poly *p)
+{
+    return !PolyIsSmallCoeff(p) && p->length < 0;
+}
+
+
+/**
+ * Zwraca cyfry współczynnika; cyfry współczynnika mieszczącego się w <c>poly_coeff_t</c> trafiają do bufora.
+ * @param p współczynnik
+ * @param buffer bufor na jedną cyfrę
+ * @return cyfry współczynnika
+ */
+static inline CoeffDigits CoeffGetDigits(const Poly *p, uint64_t *buffer)
+{
+    if (!PolyIsBigCoeff(p)) {
+        *buffer = p->asCoef < 0 ? 0 - (uint64_t)p->asCoef : (uint64_t)p->asCoef;
+        return (CoeffDigits){.limbs = buffer, .size = p->asCoef != 0, .negative = p->asCoef < 0};
+    }
+    const BigCoeff *big = (const BigCoeff *)p->monos;
+    return (CoeffDigits){.limbs = big->limbs, .size = big->size, .negative = big->negative};
+}
+
+
+/**
+ * Alokuje duży współczynnik.
+ * @param size liczba cyfr
+ * @param negative znak
+ * @return niezainicjowane cyfry współczynnika
+ */
+static BigCoeff *BigCoeffAlloc(uint32_t size, bool negative)
+{
+    BigCoeff *big = malloc(sizeof(BigCoeff) + sizeof(uint64_t) * size);
+    assert(big != NULL);
+    big->references = 1;
+    big->size = size;
+    big->negative = negative;
+    return big;
+}
+
+
+/**
+ * Tworzy współczynnik z cyfr (przejmowanych na własność), pomijając wiodące zera; wartości mieszczące się w
+ * <c>poly_coeff_t</c> są zapisywane bezpośrednio w wielomianie, a cyfry zwalniane.
+ * @param big cyfry współczynnika
+ * @return współczynnik
+ */
+static Poly CoeffFromBig(BigCoeff *big)
+{
+    while (big->size > 0 && big->limbs[big->size - 1] == 0)
+        --big->size;
+
+    uint64_t limit = big->negative ? (uint64_t)POLY_COEFF_MAX + 1 : (uint64_t)POLY_COEFF_MAX;
+    if (big->size == 0 || (big->size == 1 && big->limbs[0] <= limit)) {
+        uint64_t magnitude = big->size == 0 ? 0 : big->limbs[0];
+        bool negative = big->negative;
+        free(big);
+        return PolyFromCoeff((poly_coeff_t)(negative ? 0 - magnitude : magnitude));
+    }
+
+    Poly p;
+    p.monos = (Mono *)big;
+    p.length = POLY_BIG_COEFF_LENGTH;
+    return p;
+}
+
+
+/**
+ * Porównuje wartości bezwzględne liczb.
+ * @param a pierwsza liczba
+ * @param b druga liczba
+ * @return liczba ujemna, zero lub dodatnia, gdy \f$ |a| \f$ jest odpowiednio mniejsze, równe lub większe od \f$ |b| \f$
+ */
+static int DigitsCompare(CoeffDigits a, CoeffDigits b)
+{
+    if (a.size != b.size)
+        return a.size < b.size ? -1 : 1;
+    for (uint32_t i = a.size; i-- > 0;) {
+        if (a.limbs[i] != b.limbs[i])
+            return a.limbs[i] < b.limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+
+/**
+ * Dodaje duże współczynniki.
+ * @param p współczynnik
+ * @param q współczynnik
+ * @return \f$ p + q \f$
+ */
+static Poly CoeffSumBig(const Poly *p, const Poly *q)
+{
+    uint64_t p_buffer, q_buffer;
+    CoeffDigits a = CoeffGetDigits(p, &p_buffer), b = CoeffGetDigits(q, &q_buffer);
+    if (DigitsCompare(a, b) < 0) {
+        CoeffDigits swap = a;
+        a = b;
+        b = swap;
+    }
+
+    BigCoeff *sum = BigCoeffAlloc(a.size + 1, a.negative);
+    uint64_t carry = 0;
+    for (uint32_t i = 0; i < a.size; ++i) {
+        uint64_t digit = i < b.size ? b.limbs[i] : 0;
+        if (a.negative == b.negative) {
+            unsigned __int128 total = (unsigned __int128)a.limbs[i] + digit + carry;
+            sum->limbs[i] = (uint64_t)total;
+            carry = (uint64_t)(total >> 64);
+        } else {
+            unsigned __int128 subtrahend = (unsigned __int128)digit + carry;
+            sum->limbs[i] = a.limbs[i] - (uint64_t)subtrahend;
+            carry = subtrahend > a.limbs[i];
+        }
+    }
+    sum->limbs[a.size] = a.negative == b.negative ? carry : 0;
+    return CoeffFromBig(sum);
+}
+
+
+/**
+ * Mnoży duże współczynniki (metodą szkolną).
+ * @param p współczynnik
+ * @param q współczynnik
+ * @return \f$ pq \f$
+ */
+static Poly CoeffProductBig(const Poly *p, const Poly *q)
+{
+    uint64_t p_buffer, q_buffer;
+    CoeffDigits a = CoeffGetDigits(p, &p_buffer), b = CoeffGetDigits(q, &q_buffer);
+    BigCoeff *product = BigCoeffAlloc(a.size + b.size, a.negative != b.negative);
+    memset(product->limbs, 0, sizeof(uint64_t) * product->size);
+    for (uint32_t i = 0; i < a.size; ++i) {
+        uint64_t carry = 0;
+        for (uint32_t j = 0; j < b.size; ++j) {
+            unsigned __int128 total = (unsigned __int128)a.limbs[i] * b.limbs[j] + product->limbs[i + j] + carry;
+            product->limbs[i + j] = (uint64_t)total;
+            carry = (uint64_t)(total >> 64);
+        }
+        product->limbs[i + b.size] = carry;
+    }
+    return CoeffFromBig(product);
+}
+
+
+/**
+ * Dodaje współczynniki; w trybie dokładnym przepełnienie jest wykrywane i wynik trafia do dużego współczynnika.
+ * @param p współczynnik
+ * @param q współczynnik
+ * @return \f$ p + q \f$
+ */
+static inline Poly CoeffSum(const Poly *p, const Poly *q)
+{
+    if (!PolyIsBigCoeff(p) && !PolyIsBigCoeff(q)) {
+        poly_coeff_t sum;
+        if (!CoeffMaySpill())
+            return PolyFromCoeff(CoeffAdd(p->asCoef, q->asCoef));
+        if (!__builtin_add_overflow(p->asCoef, q->asCoef, &sum))
+            return PolyFromCoeff(sum);
+    }
+    return CoeffSumBig(p, q);
+}
+
+
+/**
+ * Mnoży współczynniki; w trybie dokładnym przepełnienie jest wykrywane i wynik trafia do dużego współczynnika.
+ * @param p współczynnik
+ * @param q współczynnik
+ * @return \f$ pq \f$
+ */
+static inline Poly CoeffProduct(const Poly *p, const Poly *q)
+{
+    if (!PolyIsBigCoeff(p) && !PolyIsBigCoeff(q)) {
+        poly_coeff_t product;
+        if (!CoeffMaySpill())
+            return PolyFromCoeff(CoeffMul(p->asCoef, q->asCoef));
+        if (!__builtin_mul_overflow(p->asCoef, q->asCoef, &product))
+            return PolyFromCoeff(product);
+    }
+    return CoeffProductBig(p, q);
+}
+
+
+/**
+ * Neguje współczynnik; w trybie dokładnym \f$ -\text{POLY_COEFF_MIN} \f$ trafia do dużego współczynnika.
+ * @param p współczynnik
+ * @return \f$ -p \f$
+ */
+static Poly CoeffNegation(const Poly *p)
+{
+    if (!PolyIsBigCoeff(p) && (!CoeffMaySpill() || p->asCoef != POLY_COEFF_MIN))
+        return PolyFromCoeff(CoeffNeg(p->asCoef));
+
+    uint64_t buffer;
+    CoeffDigits digits = CoeffGetDigits(p, &buffer);
+    BigCoeff *negated = BigCoeffAlloc(digits.size, !digits.negative);
+    memcpy(negated->limbs, digits.limbs, sizeof(uint64_t) * digits.size);
+    return CoeffFromBig(negated);
+}
+
+
+/**
+ * Potęguje współczynnik (szybkie potęgowanie na współczynnikach, także dużych).
+ * @param base podstawa
+ * @param exponent wykładnik (nieujemny)
+ * @return \f$ \text{base}^\text{exponent} \f$
+ */
+static Poly CoeffPower(const Poly *base, poly_exp_t exponent)
+{
+    Poly result = PolyFromCoeff(1), square = PolyClone(base);
+    for (; exponent > 0; exponent /= 2) {
+        if (exponent % 2 == 1) {
+            Poly next = CoeffProduct(&result, &square);
+            PolyDestroy(&result);
+            result = next;
+        }
+        if (exponent > 1) {
+            Poly next = CoeffProduct(&square, &square);
+            PolyDestroy(&square);
+            square = next;
+        }
+    }
+    PolyDestroy(&square);
+    return result;
+}
+
+
+/**
+ * Sprawdza równość współczynników; duże współczynniki nigdy nie są równe współczynnikom mieszczącym się w
+ * <c>poly_coeff_t</c>.
+ * @param p współczynnik
+ * @param q współczynnik
+ * @return czy <c>p == q</c>
+ */
+static bool CoeffIsEq(const Poly *p, const Poly *q)
+{
+    if (!PolyIsBigCoeff(p) || !PolyIsBigCoeff(q))
+        return !PolyIsBigCoeff(p) && !PolyIsBigCoeff(q) && p->asCoef == q->asCoef;
+    uint64_t p_buffer, q_buffer;
+    CoeffDigits a = CoeffGetDigits(p, &p_buffer), b = CoeffGetDigits(q, &q_buffer);
+    return a.negative == b.negative && DigitsCompare(a, b) == 0;
+}
+
+
+/**
+ * Sprowadza współczynnik do bieżącej arytmetyki (por. PolyReduce()).
+ * @param p współczynnik
+ * @return zredukowany współczynnik
+ */
+static Poly CoeffReduced(const Poly *p)
+{
+    if (!PolyIsBigCoeff(p))
+        return PolyFromCoeff(CoeffReduce(p->asCoef));
+    if (CoeffMaySpill())
+        return PolyClone(p);
+
+    uint64_t buffer;
+    CoeffDigits digits = CoeffGetDigits(p, &buffer);
+    uint64_t magnitude = digits.limbs[0];
+    if (PolyModular.modulus != 0) {
+        magnitude = 0;
+        for (uint32_t i = digits.size; i-- > 0;)
+            magnitude = (uint64_t)((((unsigned __int128)magnitude << 64) | digits.limbs[i]) % PolyModular.modulus);
+        return PolyFromCoeff(digits.negative ? CoeffNeg((poly_coeff_t)magnitude) : (poly_coeff_t)magnitude);
+    }
+    return PolyFromCoeff((poly_coeff_t)(digits.negative ? 0 - magnitude : magnitude));
+}
+
+
+/**
+ * Wypisuje duży współczynnik dziesiętnie.
+ * @param p duży współczynnik
+ * @param stream strumień wyjściowy
+ */
+static void CoeffPrintBig(const Poly *p, FILE *stream)
+{
+    uint64_t buffer;
+    CoeffDigits digits = CoeffGetDigits(p, &buffer);
+    uint64_t *quotient = malloc(sizeof(uint64_t) * digits.size);
+    uint64_t *chunks = malloc(sizeof(uint64_t) * 2 * digits.size);
+    assert(quotient != NULL && chunks != NULL);
+    memcpy(quotient, digits.limbs, sizeof(uint64_t) * digits.size);
+
+    uint32_t size = digits.size, count = 0;
+    do {
+        uint64_t remainder = 0;
+        for (uint32_t i = size; i-- > 0;) {
+            unsigned __int128 current = ((unsigned __int128)remainder << 64) | quotient[i];
+            quotient[i] = (uint64_t)(current / POLY_DECIMAL_CHUNK);
+            remainder = (uint64_t)(current % POLY_DECIMAL_CHUNK);
+        }
+        chunks[count++] = remainder;
+        while (size > 0 && quotient[size - 1] == 0)
+            --size;
+    } while (size > 0);
+
+    if (digits.negative)
+        fputc('-', stream);
+    fprintf(stream, "%llu", (unsigned long long)chunks[count - 1]);
+    for (uint32_t i = count - 1; i-- > 0;)
+        fprintf(stream, "%019llu", (unsigned long long)chunks[i]);
+    free(quotient);
+    free(chunks);
+}
+
+
+/**
+ * Upraszcza wielomian, jeśli ten jest zerowy i zwraca ten wielomian (uproszczony wielomian, nie uproszczoną kopię).
+ * @param p wielomian do uproszczenia
+ * @return <code>p</code> po uptrzednim uproszczeniu
+ */
+static Poly PolySimplifyCoeff(Poly p)
+{
+    if (!PolyIsCoeff(&p)) {
+        bool first_zero = PolyIsZero(&p.monos[0].p);
+        bool other_zeros = true;
+        for (poly_exp_t i = 1; i < p.length && other_zeros; ++i)
+            other_zeros &= PolyIsZero(&p.monos[i].p);
+        if (first_zero && other_zeros) {
+            PolyDestroy(&p);
+            return PolyZero();
+        } else if (other_zeros && p.monos[0].exp == 0 && PolyIsCoeff(&p.monos[0].p)) {
+            Poly nested = PolyClone(&p.monos[0].p);
+            PolyDestroy(&p);
+            return nested;
+        }
+        return PolyShareSmallTerm(p);
+    }
+    return p;
+}
+
+
+/**
+ * Sprawdza, czy wielomian jest liściem, czyli nie-współczynnikiem, którego wszystkie jednomiany mają współczynniki
+ * mieszczące się w <c>poly_coeff_t</c>.
+ * @param p wielomian
+ * @return czy <c>p</c> jest liściem
+ */
+static inline bool PolyIsLeaf(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return false;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (!PolyIsSmallCoeff(&p->monos[i].p))
+            return false;
+    }
+    return true;
+}
+
+
+/**
+ * Oblicz liczbę jednomianów w \f$ p + q \f$
+ * @param p pierwszy sumy wielomian
+ * @param q drugi wielomian sumy wielomian
+ * @return liczbę jednomianów w wynikowym wielomianie \f$ p + q \f$
+ */
+static inline poly_exp_t CountSumLength(const Poly *p, const Poly *q)
+{
+    assert(!PolyIsSmallCoeff(p) && !PolyIsSmallCoeff(q));
+
+    poly_exp_t sum_length = 0;
+    poly_exp_t i = 0, j = 0;
+
+    while (i < p->length && j < q->length) {
+        if (p->monos[i].exp < q->monos[j].exp) {
+            ++i;
+        } else if (p->monos[i].exp > q->monos[j].exp) {
+            ++j;
+        } else {
+            ++i, ++j;
+        }
+        ++sum_length;
+    }
+
+    return sum_length + (p->length - i) + (q->length - j);
+}
+
+
+/**
+ * Oblicz \f$ p + q \f$ zakładając, że tylko <c>q</c> jest współczynnikiem.
+ * To jest podprzypadek dodawania wielomianów, kiedy jeden z nich jest wspołczynnikiem, a drug nie.
+ * @param p wielomian niebędący współczynnikiem
+ * @param q wielomian będący współvczynnikiem
+ * @return wielomian \f$ p + q \f$
+ */
+static inline Poly PolyAddPC(const Poly *p, const Poly *q)
+{
+    assert(PolyIsCoeff(q) && !PolyIsCoeff(p));
+    if (PolyIsZero(q))
+        return PolyClone(p);
+
+    Poly result;
+    if (p->monos[0].exp == 0) {
+        //Trzeba zsumować
+        result.length = p->length;
+        result.monos = MonosAlloc(result.length);
+        assert(result.monos != NULL);
+        result.monos[0] = (Mono){.p = PolyAdd(q, &p->monos[0].p), .exp = 0};
+        for (poly_exp_t i = 1; i < p->length; ++i)
+            result.monos[i] = MonoClone(p->monos + i);
+    } else {
+        //Nie sumujemy
+        result.length = p->length + 1;
+        result.monos = MonosAlloc(result.length);
+        assert(result.monos != NULL);
+        result.monos[0] = (Mono){.p = PolyClone(q), .exp = 0};
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            result.monos[1 + i] = MonoClone(p->monos + i);
+    }
+
+#ifdef WILL_RUN_ILL_TESTS
+    return PolySimplifyCoeff(result);
+#else
+    return result;
+#endif
+}
+
+
+/**
+ * Dodaje liście jednym scaleniem ich tablic, sumując współczynniki wprost w <c>poly_coeff_t</c> zamiast wywoływać
+ * PolyAdd() dla każdej pary jednomianów.
+ * @param p liść
+ * @param q liść
+ * @return \f$ p + q \f$
+ */
+static Poly PolyAddLeaves(const Poly *p, const Poly *q)
+{
+    assert(PolyIsLeaf(p) && PolyIsLeaf(q) && !CoeffMaySpill());
+
+    Poly result;
+    result.length = CountSumLength(p, q);
+    result.monos = MonosAlloc(result.length);
+    assert(result.monos != NULL);
+
+    const Mono *p_monos = p->monos, *q_monos = q->monos;
+    poly_exp_t p_index = 0, q_index = 0, result_index = 0;
+    while (p_index < p->length && q_index < q->length) {
+        if (p_monos[p_index].exp < q_monos[q_index].exp) {
+            result.monos[result_index] = p_monos[p_index++];
+        } else if (p_monos[p_index].exp > q_monos[q_index].exp) {
+            result.monos[result_index] = q_monos[q_index++];
+        } else {
+            result.monos[result_index] = (Mono){
+                .p = PolyFromCoeff(CoeffAdd(p_monos[p_index].p.asCoef, q_monos[q_index].p.asCoef)),
+                .exp = p_monos[p_index].exp
+            };
+            ++p_index;
+            ++q_index;
+        }
+        ++result_index;
+    }
+
+    //Jednomiany liści nie mają liczników referencji, więc resztę wystarczy skopiować
+    memcpy(result.monos + result_index, p_monos + p_index, sizeof(Mono) * (size_t)(p->length - p_index));
+    result_index += p->length - p_index;
+    memcpy(result.monos + result_index, q_monos + q_index, sizeof(Mono) * (size_t)(q->length - q_index));
+
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Oblicz \f$ p + q \f$ zakładając, że żąden z nich nie jest współczynnikiem.
+ * To jest podprzypadek dodawania wielomianów, kiedy żaden z nich nie jest wspołczynnikiem.
+ * @param p wielomian niebędący współczynnikiem
+ * @param q wielomian niebędący współczynnikiem
+ * @return wielomian \f$ p + q \f$
+ */
+static inline Poly PolyAddPP(const Poly *p, const Poly *q)
+{
+    assert(!PolyIsSmallCoeff(p));
+    assert(!PolyIsSmallCoeff(q));
+    if (!CoeffMaySpill() && PolyIsLeaf(p) && PolyIsLeaf(q))
+        return PolyAddLeaves(p, q);
+
+    Poly result;
+    result.length = CountSumLength(p, q);
+    result.monos = MonosAlloc(result.length);
+    assert(result.monos != NULL);
+
+    poly_exp_t p_index = 0, q_index = 0, result_index = 0;
+    while (p_index < p->length && q_index < q->length) {
+        if (p->monos[p_index].exp < q->monos[q_index].exp) {
+            result.monos[result_index] = MonoClone(p->monos + p_index);
+            ++p_index;
+        } else if (p->monos[p_index].exp > q->monos[q_index].exp) {
+            result.monos[result_index] = MonoClone(q->monos + q_index);
+            ++q_index;
+        } else {
+            result.monos[result_index] = (Mono){
+                .p = PolyAdd(&p->monos[p_index].p, &q->monos[q_index].p),
+                .exp = p->monos[p_index].exp
+            };
+            ++p_index;
+            ++q_index;
+        }
+        ++result_index;
+    }
+
+    for (; p_index < p->length; ++p_index)
+        result.monos[result_index++] = MonoClone(&p->monos[p_index]);
+    for (; q_index < q->length; ++q_index)
+        result.monos[result_index++] = MonoClone(&q->monos[q_index]);
+
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Ogonowa implementacja szybkiego potęgowania dla wykładników większych od 0.
+ * @param base baza potęgi
+ * @param exponent wykładnik
+ * @param accumulator akumulator
+ * @return \f$ \text{acccumulator} \cdot \text{base}^\text{exponent} \f$
+ */
+static poly_coeff_t QuickPowerTail(poly_coeff_t base, poly_exp_t exponent, poly_coeff_t accumulator)
+{
+    if (exponent == 0)
+        return accumulator;
+    if (exponent % 2 == 0)
+        return QuickPowerTail(CoeffMul(base, base), exponent / 2, accumulator);
+    return QuickPowerTail(CoeffMul(base, base), exponent / 2, CoeffMul(accumulator, base));
+}
+
+
+/**
+ * Implementacja szybkiego potęgowania.
+ * Ta funkcja wewnętrznie odwołuje się do QuickPowerTail(), po sprawdzeniu, czy <c>exponent >= 0</c>.
+ * @param base baza potęgowania
+ * @param exponent wykładnik
+ * @return \f$ \text{base}^\text{exponent} \f$
+ */
+static inline poly_coeff_t QuickPower(poly_coeff_t base, poly_exp_t exponent)
+{
+    assert(exponent >= 0);
+    return QuickPowerTail(base, exponent, 1);
+}
+
+
+/**
+ * Mnoży w miejscu współczynniki liścia przez zredukowany współczynnik jedną pętlą, bez schodzenia rekurencyjnie do
+ * każdego jednomianu; wybór arytmetyki jest wyciągnięty przed pętlę.
+ * @param p liść, którego tablica jednomianów nie jest współdzielona
+ * @param scalar zredukowany współczynnik
+ */
+static void PolyScaleLeaf(Poly *p, poly_coeff_t scalar)
+{
+    assert(PolyIsLeaf(p) && !CoeffMaySpill());
+    Mono *monos = p->monos;
+    if (PolyModular.modulus == 0) {
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            monos[i].p.asCoef *= scalar;
+    } else {
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            monos[i].p.asCoef = CoeffMul(monos[i].p.asCoef, scalar);
+    }
+}
+
+
+/**
+ * Mnoży w miejscu wielomian przez niezerowy, zredukowany współczynnik.
+ * @param p wielomian, który ma zostać pomnożony
+ * @param scalar współczynnik (także duży)
+ */
+static void PolyScaleByCoeff(Poly *p, const Poly *scalar)
+{
+    if (PolyIsSmallCoeff(p) && PolyIsSmallCoeff(scalar) && !CoeffMaySpill()) {
+        p->asCoef = CoeffMul(p->asCoef, scalar->asCoef);
+    } else if (PolyIsSmallCoeff(scalar) && !CoeffMaySpill() && PolyIsLeaf(p)) {
+        PolyMakeUnique(p);
+        PolyScaleLeaf(p, scalar->asCoef);
+    } else if (!PolyIsCoeff(p)) {
+        PolyMakeUnique(p);
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            PolyScaleByCoeff(&p->monos[i].p, scalar);
+    } else {
+        Poly product = CoeffProduct(p, scalar);
+        PolyDestroy(p);
+        *p = product;
+    }
+}
+
+
+void PolyScaleInplace(Poly *p, poly_coeff_t scalar)
+{
+    Poly reduced = PolyFromCoeff(CoeffReduce(scalar));
+    if (PolyIsZero(&reduced)) {
+        PolyDestroy(p);
+        *p = PolyZero();
+    } else {
+        PolyScaleByCoeff(p, &reduced);
+    }
+}
+
+
+/**
+ * Zwraca wielomian-nie-współczynnik pomnożony przez jednomian.
+ * @param p wielomian; nie może być współczynnikiem
+ * @param q jednomian
+ * @return \f$ q * q \f$
+ */
+static Poly PolyMulM(const Poly *p, const Mono *q)
+{
+    assert(!PolyIsSmallCoeff(p));
+    if (PolyIsZero(&q->p))
+        return PolyZero();
+
+    Poly result;
+    result.length = p->length;
+    result.monos = MonosAlloc(result.length);
+    assert(result.monos != NULL);
+
+    //Trzeba ,,rozpakować'' wielomian p, bo inaczej zmniejszami indeksy zmiennych w q, a nie w p
+    //i dzieją się dziwne rzeczy
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        result.monos[i].exp = q->exp + p->monos[i].exp;
+        result.monos[i].p = PolyMul(&p->monos[i].p, &q->p);
+    }
+
+#ifdef WILL_RUN_ILL_TESTS
+    return PolySimplifyCoeff(result);
+#else
+    return result;
+#endif
+}
+
+
+/**
+ * Sortuje krótką tablicę jednomianów niemalejąco według wykładników (sortowanie przez wstawianie).
+ * Sortowanie jest stabilne.
+ * @param monos tablica jednomianów do posortowania
+ * @param length długość tablicy <c>monos</c>
+ */
+static void PolyInsertionSortMonos(Mono *monos, poly_exp_t length)
+{
+    for (poly_exp_t i = 1; i < length; ++i) {
+        Mono m = monos[i];
+        poly_exp_t j = i;
+        for (; j > 0 && monos[j - 1].exp > m.exp; --j)
+            monos[j] = monos[j - 1];
+        monos[j] = m;
+    }
+}
+
+
+/**
+ * Sortuje tablicę jednomianów niemalejąco według ich wykładnika.
+ * Jednomiany o tych samych wykładnikach nie są scalane. Długie tablice są sortowane pozycyjnie (LSD radix sort po
+ * <c>POLY_RADIX_BITS</c> bitów wykładnika) z jednym buforem pomocniczym; przebiegi, w których wszystkie wykładniki
+ * mają tę samą cyfrę, są pomijane, a liczba przebiegów jest ograniczona przez największy wykładnik.
+ * @param monos tablica jednomianów do posortowania
+ * @param length długość tablicy <c>monos</c>
+ */
+static void PolySortMonos(Mono *monos, poly_exp_t length)
+{
+    if (length <= POLY_INSERTION_SORT_THRESHOLD) {
+        PolyInsertionSortMonos(monos, length);
+        return;
+    }
+
+    uint32_t exp_bits = 0;
+    for (poly_exp_t i = 0; i < length; ++i) {
+        assert(monos[i].exp >= 0);
+        exp_bits |= (uint32_t)monos[i].exp;
+    }
+
+    Mono *scratch = malloc(sizeof(Mono) * length);
+    assert(scratch != NULL);
+    Mono *from = monos, *to = scratch;
+    for (unsigned shift = 0; shift < 32 && (exp_bits >> shift) != 0; shift += POLY_RADIX_BITS) {
+        size_t offsets[1 << POLY_RADIX_BITS] = {0};
+        for (poly_exp_t i = 0; i < length; ++i)
+            ++offsets[((uint32_t)from[i].exp >> shift) & ((1u << POLY_RADIX_BITS) - 1)];
+        if (offsets[((uint32_t)from[0].exp >> shift) & ((1u << POLY_RADIX_BITS) - 1)] == (size_t)length)
+            continue;
+
+        size_t position = 0;
+        for (unsigned digit = 0; digit < (1u << POLY_RADIX_BITS); ++digit) {
+            size_t count = offsets[digit];
+            offsets[digit] = position;
+            position += count;
+        }
+        for (poly_exp_t i = 0; i < length; ++i)
+            to[offsets[((uint32_t)from[i].exp >> shift) & ((1u << POLY_RADIX_BITS) - 1)]++] = from[i];
+
+        Mono *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != monos)
+        memcpy(monos, from, sizeof(Mono) * length);
+    free(scratch);
+}
+
+
+/**
+ * Scala posortowane serie jednomianów (naturalne sortowanie przez scalanie) z jednym buforem pomocniczym.
+ * Scalanie jest stabilne; jednomiany o tym samym wykładniku nie są scalane.
+ * @param monos tablica jednomianów
+ * @param length długość tablicy <c>monos</c>
+ * @param bounds początki kolejnych serii oraz <c>length</c> na pozycji <c>runs</c>; tablica jest modyfikowana
+ * @param runs liczba serii
+ */
+static void PolyMergeRuns(Mono *monos, poly_exp_t length, poly_exp_t *bounds, unsigned runs)
+{
+    Mono *scratch = malloc(sizeof(Mono) * length);
+    assert(scratch != NULL);
+    Mono *from = monos, *to = scratch;
+
+    while (runs > 1) {
+        unsigned merged = 0;
+        for (unsigned r = 0; r < runs; r += 2) {
+            poly_exp_t begin = bounds[r];
+            if (r + 1 == runs) {
+                memcpy(to + begin, from + begin, sizeof(Mono) * (length - begin));
+            } else {
+                poly_exp_t i = begin, j = bounds[r + 1], k = begin;
+                poly_exp_t mid = j, end = bounds[r + 2];
+                while (i < mid && j < end)
+                    to[k++] = from[j].exp < from[i].exp ? from[j++] : from[i++];
+                memcpy(to + k, from + i, sizeof(Mono) * (mid - i));
+                memcpy(to + k + mid - i, from + j, sizeof(Mono) * (end - j));
+            }
+            bounds[merged++] = begin;
+        }
+        bounds[merged] = length;
+        runs = merged;
+
+        Mono *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != monos)
+        memcpy(monos, from, sizeof(Mono) * length);
+    free(scratch);
+}
+
+
+/**
+ * Sortuje tablicę jednomianów niemalejąco według wykładników, wykorzystując jej istniejące uporządkowanie.
+ * Gdy tablica składa się z co najwyżej <c>POLY_NATURAL_MERGE_MAX_RUNS</c> posortowanych serii, serie są scalane;
+ * w.p.p. używamy PolySortMonos().
+ * @param monos tablica jednomianów do posortowania
+ * @param length długość tablicy <c>monos</c>
+ */
+static void PolySortRuns(Mono *monos, poly_exp_t length)
+{
+    poly_exp_t bounds[POLY_NATURAL_MERGE_MAX_RUNS + 1] = {0};
+    unsigned runs = 1;
+    poly_exp_t k = 1;
+    for (; k < length; ++k) {
+        if (monos[k].exp < monos[k - 1].exp) {
+            if (runs == POLY_NATURAL_MERGE_MAX_RUNS)
+                break;
+            bounds[runs++] = k;
+        }
+    }
+
+    if (k < length) {
+        PolySortMonos(monos, length);
+    } else if (runs > 1) {
+        bounds[runs] = length;
+        PolyMergeRuns(monos, length, bounds, runs);
+    }
+}
+
+
+/**
+ * Scala jednomiany o równych wykładnikach w posortowanym prefiksie tablicy.
+ * Przechodzi tablicę, dopóki wykładniki nie maleją; złożone jednomiany prefiksu trafiają na początek tablicy.
+ * @param monos tablica jednomianów
+ * @param length długość tablicy <c>monos</c> (dodatnia)
+ * @param folded miejsce na liczbę jednomianów po scaleniu prefiksu
+ * @return długość posortowanego prefiksu (równa <c>length</c>, gdy cała tablica była posortowana)
+ */
+static poly_exp_t PolyFoldSortedPrefix(Mono *monos, poly_exp_t length, poly_exp_t *folded)
+{
+    poly_exp_t i = 0, j = 1;
+    for (; j < length && monos[j].exp >= monos[i].exp; ++j) {
+        if (monos[i].exp == monos[j].exp) {
+            Poly p = PolyAdd(&monos[i].p, &monos[j].p);
+            PolyDestroy(&monos[i].p);
+            PolyDestroy(&monos[j].p);
+            monos[i].p = p;
+        } else {
+            ++i;
+            monos[i] = monos[j];
+        }
+    }
+    *folded = i + 1;
+    return j;
+}
+
+
+/**
+ * Dane równoległego sortowania i scalania jednomianów w PolyFromMonos().
+ * Tablica jest dzielona na fragmenty, które są sortowane niezależnie, a następnie scalane parami w kolejnych
+ * rundach; scalenie każdej pary jest dodatkowo dzielone na <c>segments</c> niezależnych kawałków wyjścia.
+ */
+typedef struct
+{
+    ///Tablica, z której czytamy w bieżącej rundzie
+    Mono *from;
+
+    ///Tablica, do której piszemy w bieżącej rundzie
+    Mono *to;
+
+    ///Początki kolejnych fragmentów oraz długość tablicy na pozycji <c>runs</c>
+    poly_exp_t *bounds;
+
+    ///Liczba fragmentów
+    unsigned runs;
+
+    ///Liczba kawałków, na które dzielone jest scalenie jednej pary fragmentów
+    unsigned segments;
+
+    ///Liczby jednomianów we fragmentach po scaleniu równych wykładników
+    poly_exp_t *folded;
+} PolySortJob;
+
+
+/**
+ * Sortuje jeden fragment tablicy.
+ * @param context wskaźnik na <c>PolySortJob</c>
+ * @param run indeks fragmentu
+ */
+static void PolySortRunTask(void *context, size_t run)
+{
+    PolySortJob *job = context;
+    PolySortRuns(job->from + job->bounds[run], job->bounds[run + 1] - job->bounds[run]);
+}
+
+
+/**
+ * Wyznacza, ile spośród pierwszych <c>k</c> jednomianów stabilnego scalenia tablic <c>a</c> i <c>b</c> pochodzi z
+ * tablicy <c>a</c> (wyszukiwanie binarne po ,,ścieżce scalania'').
+ * @param a pierwsza posortowana tablica
+ * @param m długość tablicy <c>a</c>
+ * @param b druga posortowana tablica
+ * @param n długość tablicy <c>b</c>
+ * @param k długość prefiksu wyniku
+ * @return liczba jednomianów z tablicy <c>a</c>
+ */
+static poly_exp_t PolyMergeSplit(const Mono *a, poly_exp_t m, const Mono *b, poly_exp_t n, poly_exp_t k)
+{
+    poly_exp_t low = k > n ? k - n : 0;
+    poly_exp_t high = k < m ? k : m;
+    while (low < high) {
+        poly_exp_t i = low + (high - low) / 2;
+        if (b[k - i - 1].exp >= a[i].exp)
+            low = i + 1;
+        else
+            high = i;
+    }
+    return low;
+}
+
+
+/**
+ * Scala jeden kawałek jednej pary fragmentów (albo kopiuje kawałek fragmentu bez pary).
+ * @param context wskaźnik na <c>PolySortJob</c>
+ * @param index numer pary razy <c>segments</c> plus numer kawałka
+ */
+static void PolyMergeRunTask(void *context, size_t index)
+{
+    PolySortJob *job = context;
+    unsigned r = 2 * (unsigned)(index / job->segments);
+    int64_t segment = (int64_t)(index % job->segments);
+
+    poly_exp_t begin = job->bounds[r];
+    poly_exp_t mid = job->bounds[r + 1];
+    poly_exp_t end = r + 1 == job->runs ? mid : job->bounds[r + 2];
+    poly_exp_t k0 = (poly_exp_t)((end - begin) * segment / job->segments);
+    poly_exp_t k1 = (poly_exp_t)((end - begin) * (segment + 1) / job->segments);
+    Mono *out = job->to + begin + k0;
+    if (r + 1 == job->runs) {
+        memcpy(out, job->from + begin + k0, sizeof(Mono) * (k1 - k0));
+        return;
+    }
+
+    const Mono *a = job->from + begin, *b = job->from + mid;
+    poly_exp_t m = mid - begin, n = end - mid;
+    poly_exp_t i = PolyMergeSplit(a, m, b, n, k0), j = k0 - i;
+    poly_exp_t i_end = PolyMergeSplit(a, m, b, n, k1), j_end = k1 - i_end;
+    while (i < i_end && j < j_end)
+        *out++ = b[j].exp < a[i].exp ? b[j++] : a[i++];
+    memcpy(out, a + i, sizeof(Mono) * (i_end - i));
+    memcpy(out + i_end - i, b + j, sizeof(Mono) * (j_end - j));
+}
+
+
+/**
+ * Scala jednomiany o równych wykładnikach w jednym fragmencie posortowanej tablicy.
+ * @param context wskaźnik na <c>PolySortJob</c>
+ * @param run indeks fragmentu
+ */
+static void PolyFoldRunTask(void *context, size_t run)
+{
+    PolySortJob *job = context;
+    poly_exp_t length = job->bounds[run + 1] - job->bounds[run];
+    job->folded[run] = 0;
+    if (length > 0)
+        PolyFoldSortedPrefix(job->from + job->bounds[run], length, job->folded + run);
+}
+
+
+/**
+ * Wielowątkowa wersja PolyFromMonos() dla bardzo długich tablic.
+ * Fragmenty tablicy są sortowane na wątkach roboczych, scalane parami w \f$ \lceil \log_2 t \rceil \f$ rundach
+ * (każde scalenie jest dzielone na kawałki wyjścia), po czym równe wykładniki są scalane we fragmentach, których
+ * granice nie rozdzielają jednomianów o tym samym wykładniku.
+ * @param monos tablica jednomianów (przejmowana na własność)
+ * @param length długość tablicy <c>monos</c>
+ * @return wielomian będący sumą jednomianów
+ */
+static Poly PolyFromMonosParallel(Mono *monos, poly_exp_t length)
+{
+    unsigned threads = PolyGetThreadCount();
+    PolySortJob job = {.from = monos, .runs = threads};
+    job.to = malloc(sizeof(Mono) * length);
+    job.bounds = malloc(sizeof(poly_exp_t) * (threads + 1));
+    job.folded = malloc(sizeof(poly_exp_t) * threads);
+    assert(job.to != NULL && job.bounds != NULL && job.folded != NULL);
+
+    for (unsigned r = 0; r <= threads; ++r)
+        job.bounds[r] = (poly_exp_t)((int64_t)length * r / threads);
+    PolyParallelFor(job.runs, PolySortRunTask, &job);
+
+    while (job.runs > 1) {
+        unsigned pairs = (job.runs + 1) / 2;
+        job.segments = (threads + pairs - 1) / pairs;
+        PolyParallelFor((size_t)pairs * job.segments, PolyMergeRunTask, &job);
+
+        for (unsigned r = 0; r < pairs; ++r)
+            job.bounds[r] = job.bounds[2 * r];
+        job.bounds[pairs] = length;
+        job.runs = pairs;
+
+        Mono *swap = job.from;
+        job.from = job.to;
+        job.to = swap;
+    }
+
+    job.runs = threads;
+    for (unsigned r = 1; r < threads; ++r) {
+        poly_exp_t start = (poly_exp_t)((int64_t)length * r / threads);
+        start = start > job.bounds[r - 1] ? start : job.bounds[r - 1];
+        while (start > 0 && start < length && job.from[start].exp == job.from[start - 1].exp)
+            ++start;
+        job.bounds[r] = start;
+    }
+    job.bounds[threads] = length;
+    PolyParallelFor(job.runs, PolyFoldRunTask, &job);
+
+    poly_exp_t folded = 0;
+    for (unsigned r = 0; r < threads; ++r) {
+        memmove(monos + folded, job.from + job.bounds[r], sizeof(Mono) * job.folded[r]);
+        folded += job.folded[r];
+    }
+
+    free(job.from == monos ? job.to : job.from);
+    free(job.bounds);
+    free(job.folded);
+
+    Poly p;
+    p.monos = monos;
+    p.length = folded;
+    return PolySimplifyCoeff(p);
+}
+
+
+/**
+ * Tworzy wielomian zbudowany z sumy jednomianów podanych w tablicy.
+ * Wielomian przejmuje na własność tablicę jednomianów i staje się ona jego wewnętrzną tablicą. W związku z tym, tablica
+ * nowego wielomianu będzie za duża, kiedy w wejściowej tablicy <c>monos</c> będą jednomiany o takim samym wykładniku.
+ * Te nadmiarowe jednomiany będą znajdować się na końcu tablicy. Pole <c>length</c> struktury wielomianu będzie
+ * zawierało liczbę tylko prawidłowych jednomianów w tablicy, więc może być mniejsza niż wejściowa długość tablicy
+ * jednomianów.
+ * Posortowane wejście jest sprawdzane i scalane w jednym przejściu; w.p.p. resztę tablicy sortujemy i scalamy
+ * ponownie.
+ * @param monos tablica jednomianów (przejmowana na własność)
+ * @param length długosć tablicy <c>monos</c>
+ * @return
+ */
+static Poly PolyFromMonos(Mono *monos, poly_exp_t length)
+{
+    if (length == 0) {
+        MonosFree(monos);
+        return PolyZero();
+    }
+    if (length >= POLY_PARALLEL_SORT_THRESHOLD && PolyGetThreadCount() > 1)
+        return PolyFromMonosParallel(monos, length);
+
+    poly_exp_t folded;
+    poly_exp_t sorted = PolyFoldSortedPrefix(monos, length, &folded);
+    if (sorted < length) {
+        memmove(monos + folded, monos + sorted, sizeof(Mono) * (length - sorted));
+        PolySortRuns(monos, folded + length - sorted);
+        PolyFoldSortedPrefix(monos, folded + length - sorted, &folded);
+    }
+
+    Poly p;
+    p.monos = monos;
+    p.length = folded;
+    return PolySimplifyCoeff(p);
+}
+
+
+/**
+ * Dodaje do akumulatora iloczyn współczynników.
+ * Bez modułu akumulator jest liczbą ze znakiem modulo \f$ 2^{128} \f$, a przekroczenie zakresu <c>__int128</c>
+ * ustawia <c>overflow</c>. Z modułem akumulator jest utrzymywany poniżej \f$ \text{modulus} \cdot R \f$, czyli w
+ * dziedzinie MontgomeryReduce().
+ * @param accumulator akumulator
+ * @param a zredukowany czynnik
+ * @param b zredukowany czynnik
+ * @param modulus moduł bieżącej arytmetyki albo 0
+ * @param overflow flaga przepełnienia akumulatora
+ */
+static inline void LeafAccumulate(unsigned __int128 *accumulator, poly_coeff_t a, poly_coeff_t b, uint64_t modulus,
+                                  bool *overflow)
+{
+    if (modulus != 0) {
+        unsigned __int128 limit = (unsigned __int128)modulus << 64;
+        *accumulator += (unsigned __int128)(uint64_t)a * (uint64_t)b;
+        if (*accumulator >= limit)
+            *accumulator -= limit;
+    } else {
+        __int128 sum;
+        *overflow |= __builtin_add_overflow((__int128)*accumulator, (__int128)a * b, &sum);
+        *accumulator = (unsigned __int128)sum;
+    }
+}
+
+
+/**
+ * Zawęża akumulator do współczynnika w bieżącej arytmetyce.
+ * Bez modułu wartości spoza <c>poly_coeff_t</c> są obcinane modulo \f$ 2^{\text{POLY_COEFF_BITS}} \f$ albo, w trybie
+ * dokładnym, trafiają do dużego współczynnika.
+ * @param accumulator akumulator (zob. LeafAccumulate())
+ * @param modulus moduł bieżącej arytmetyki albo 0
+ * @param overflow czy któryś z akumulatorów przekroczył zakres <c>__int128</c>
+ * @param strict czy wartości spoza <c>poly_coeff_t</c> są błędem niezależnie od trybu
+ * @param out miejsce na współczynnik
+ * @return <c>false</c>, gdy współczynnika nie da się dokładnie zapisać
+ */
+static inline bool LeafNarrow(unsigned __int128 accumulator, uint64_t modulus, bool overflow, bool strict, Poly *out)
+{
+    if (modulus != 0) {
+        uint64_t reduced = MontgomeryReduce(accumulator);
+        *out = PolyFromCoeff((poly_coeff_t)MontgomeryReduce((unsigned __int128)reduced * PolyModular.r_squared));
+        return true;
+    }
+
+    __int128 value = (__int128)accumulator;
+    if (!overflow && value >= POLY_COEFF_MIN && value <= POLY_COEFF_MAX) {
+        *out = PolyFromCoeff((poly_coeff_t)value);
+        return true;
+    }
+    if (!strict && !CoeffMaySpill()) {
+        *out = PolyFromCoeff((poly_coeff_t)(uint64_t)accumulator);
+        return true;
+    }
+    if (strict || overflow)
+        return false;
+
+    unsigned __int128 magnitude = value < 0 ? -accumulator : accumulator;
+    BigCoeff *big = BigCoeffAlloc(2, value < 0);
+    big->limbs[0] = (uint64_t)magnitude;
+    big->limbs[1] = (uint64_t)(magnitude >> 64);
+    *out = CoeffFromBig(big);
+    return true;
+}
+
+
+/**
+ * Dopisuje jednomian iloczynu liści o zsumowanym współczynniku (pomijając zera).
+ * @param monos tablica jednomianów wyniku
+ * @param length liczba jednomianów w <c>monos</c>
+ * @param exp wykładnik
+ * @param accumulator suma iloczynów współczynników o wykładniku <c>exp</c>
+ * @param modulus moduł bieżącej arytmetyki albo 0
+ * @param overflow czy któryś z akumulatorów przekroczył zakres <c>__int128</c>
+ * @param strict jak w LeafNarrow()
+ * @return <c>false</c>, gdy współczynnika nie da się dokładnie zapisać
+ */
+static inline bool LeafAppend(Mono *monos, poly_exp_t *length, poly_exp_t exp, unsigned __int128 accumulator,
+                              uint64_t modulus, bool overflow, bool strict)
+{
+    Poly coef;
+    if (!LeafNarrow(accumulator, modulus, overflow, strict, &coef))
+        return false;
+    if (!PolyIsZero(&coef))
+        monos[(*length)++] = (Mono){.p = coef, .exp = exp};
+    return true;
+}
+
+
+/**
+ * Para jednomianów iloczynu liści w kopcu: kolejny nieprzetworzony jednomian wiersza <c>row</c>.
+ */
+typedef struct
+{
+    ///Wykładnik iloczynu pary
+    poly_exp_t exp;
+
+    ///Indeks jednomianu krótszego czynnika
+    poly_exp_t row;
+
+    ///Indeks jednomianu dłuższego czynnika
+    poly_exp_t col;
+} LeafHeapEntry;
+
+
+/**
+ * Przywraca własność kopca minimalnego (według wykładników) od korzenia.
+ * @param heap kopiec
+ * @param size liczba elementów kopca
+ */
+static inline void LeafHeapSiftDown(LeafHeapEntry *heap, poly_exp_t size)
+{
+    LeafHeapEntry entry = heap[0];
+    poly_exp_t index = 0;
+    for (poly_exp_t child = 1; child < size; child = 2 * index + 1) {
+        if (child + 1 < size && heap[child + 1].exp < heap[child].exp)
+            ++child;
+        if (entry.exp <= heap[child].exp)
+            break;
+        heap[index] = heap[child];
+        index = child;
+    }
+    heap[index] = entry;
+}
+
+
+/**
+ * Mnoży liście, sumując iloczyny współczynników o tym samym wykładniku w akumulatorach 128-bitowych i zawężając każdą
+ * sumę raz, na końcu. Gdy wykładniki wyniku są gęste, sumy leżą w tablicy indeksowanej wykładnikiem; w.p.p. pary
+ * jednomianów są scalane kopcem wierszy krótszego czynnika, więc wyraz wyniku powstaje w kolejności wykładników.
+ * Nie ma alokacji na pojedyncze iloczyny.
+ * @param p liść
+ * @param q liść
+ * @param strict czy współczynniki spoza <c>poly_coeff_t</c> są błędem także bez trybu dokładnego (bez modułu)
+ * @param out miejsce na wynik
+ * @return <c>false</c>, gdy któregoś ze współczynników nie da się dokładnie zapisać (wtedy <c>out</c> nie jest
+ * zmieniany); bez <c>strict</c> zdarza się to tylko w trybie dokładnym, gdy suma przekroczy zakres <c>__int128</c>
+ */
+static bool PolyMulLeaves(const Poly *p, const Poly *q, bool strict, Poly *out)
+{
+    assert(PolyIsLeaf(p) && PolyIsLeaf(q));
+    if (p->length > q->length) {
+        const Poly *swap = p;
+        p = q;
+        q = swap;
+    }
+
+    uint64_t modulus = PolyModular.modulus;
+    bool overflow = false;
+    size_t products = (size_t)p->length * (size_t)q->length;
+    poly_exp_t low = p->monos[0].exp + q->monos[0].exp;
+    size_t span = (size_t)(p->monos[p->length - 1].exp + q->monos[q->length - 1].exp - low) + 1;
+    size_t capacity = span < products ? span : products;
+    Mono *monos = MonosAlloc(capacity);
+    assert(monos != NULL);
+    poly_exp_t length = 0;
+    bool ok = true;
+
+    if (span <= POLY_LEAF_DENSE_FACTOR * products) {
+        unsigned __int128 *sums = calloc(span, sizeof(unsigned __int128));
+        assert(sums != NULL);
+        for (poly_exp_t i = 0; i < p->length; ++i) {
+            unsigned __int128 *row = sums + (p->monos[i].exp - p->monos[0].exp);
+            poly_coeff_t a = p->monos[i].p.asCoef;
+            for (poly_exp_t j = 0; j < q->length; ++j)
+                LeafAccumulate(row + (q->monos[j].exp - q->monos[0].exp), a, q->monos[j].p.asCoef, modulus, &overflow);
+        }
+        //Przepełniony akumulator mógł wrócić do zera, więc nie wolno go pominąć
+        ok = !overflow || (!strict && !CoeffMaySpill());
+        for (size_t k = 0; k < span && ok; ++k) {
+            if (sums[k] != 0)
+                ok = LeafAppend(monos, &length, low + (poly_exp_t)k, sums[k], modulus, overflow, strict);
+        }
+        free(sums);
+    } else {
+        LeafHeapEntry *heap = malloc(sizeof(LeafHeapEntry) * p->length);
+        assert(heap != NULL);
+        //Wiersze są posortowane według wykładników, więc od razu tworzą kopiec
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            heap[i] = (LeafHeapEntry){.exp = p->monos[i].exp + q->monos[0].exp, .row = i, .col = 0};
+
+        poly_exp_t size = p->length;
+        poly_exp_t exp = low;
+        unsigned __int128 accumulator = 0;
+        while (size > 0 && ok) {
+            LeafHeapEntry *top = heap;
+            if (top->exp != exp) {
+                ok = LeafAppend(monos, &length, exp, accumulator, modulus, overflow, strict);
+                exp = top->exp;
+                accumulator = 0;
+            }
+            LeafAccumulate(&accumulator, p->monos[top->row].p.asCoef, q->monos[top->col].p.asCoef, modulus,
+                           &overflow);
+            if (++top->col < q->length)
+                top->exp = p->monos[top->row].exp + q->monos[top->col].exp;
+            else
+                *top = heap[--size];
+            LeafHeapSiftDown(heap, size);
+        }
+        if (ok)
+            ok = LeafAppend(monos, &length, exp, accumulator, modulus, overflow, strict);
+        free(heap);
+    }
+
+    if (!ok) {
+        for (poly_exp_t i = 0; i < length; ++i)
+            MonoDestroy(monos + i);
+        MonosFree(monos);
+        return false;
+    }
+    if (length == 0) {
+        MonosFree(monos);
+        *out = PolyZero();
+        return true;
+    }
+    *out = PolySimplifyCoeff((Poly){.monos = monos, .length = length});
+    return true;
+}
+
+
+/**
+ * Miesza bity 64-bitowej liczby (funkcja kończąca generatora SplitMix64).
+ * @param x mieszana liczba
+ * @return wymieszana liczba
+ */
+static inline uint64_t HashMix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+
+/**
+ * Wpis tablicy internowania.
+ */
+typedef struct
+{
+    ///Internowana tablica jednomianów; <c>NULL</c> w pustym wpisie
+    Mono *monos;
+
+    ///Liczba jednomianów w tablicy
+    poly_exp_t length;
+
+    ///Skrót zawartości tablicy (PolyInternHash())
+    uint64_t hash;
+} PolyInternEntry;
+
+///Tablica internowania z adresowaniem otwartym; wpisy nie trzymają odwołań do tablic jednomianów
+static PolyInternEntry *PolyInternTable = NULL;
+
+///Pojemność <c>PolyInternTable</c> (potęga dwójki)
+static size_t PolyInternCapacity = 0;
+
+///Liczba zajętych wpisów <c>PolyInternTable</c>
+static size_t PolyInternCount = 0;
+
+///Chroni tablicę internowania oraz zwalnianie ostatnich odwołań do internowanych tablic
+static pthread_mutex_t PolyInternMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * Wylicza skrót zawartości tablicy jednomianów: współczynniki wchodzą do niego wartością, a podwielomiany (już
+ * internowane) adresem tablicy.
+ * @param p wielomian niebędący współczynnikiem
+ * @return skrót
+ */
+static uint64_t PolyInternHash(const Poly *p)
+{
+    uint64_t hash = HashMix(POLY_HASH_SEED ^ (uint64_t)p->length);
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        const Poly *child = &p->monos[i].p;
+        uint64_t key = (uint64_t)(uintptr_t)child->monos;
+        if (PolyIsSmallCoeff(child)) {
+            key = (uint64_t)child->asCoef;
+        } else if (PolyIsBigCoeff(child)) {
+            uint64_t buffer;
+            CoeffDigits digits = CoeffGetDigits(child, &buffer);
+            key = digits.negative;
+            for (uint32_t j = 0; j < digits.size; ++j)
+                key = HashMix(key ^ digits.limbs[j]);
+        }
+        hash = HashMix(hash ^ HashMix(key + (uint64_t)p->monos[i].exp * POLY_HASH_SEED));
+    }
+    return hash;
+}
+
+
+/**
+ * Sprawdza, czy wpis tablicy internowania ma tę samą zawartość co wielomian.
+ * @param entry niepusty wpis
+ * @param p wielomian niebędący współczynnikiem, z internowanymi podwielomianami
+ * @param hash skrót <c>p</c>
+ * @return czy zawartości są równe
+ */
+static bool PolyInternMatches(const PolyInternEntry *entry, const Poly *p, uint64_t hash)
+{
+    if (entry->hash != hash || entry->length != p->length)
+        return false;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        const Mono *a = entry->monos + i, *b = p->monos + i;
+        if (a->exp != b->exp)
+            return false;
+        if (PolyIsCoeff(&a->p) || PolyIsCoeff(&b->p)) {
+            if (!PolyIsCoeff(&a->p) || !PolyIsCoeff(&b->p) || !CoeffIsEq(&a->p, &b->p))
+                return false;
+        } else if (a->p.monos != b->p.monos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Zwraca indeks wpisu o zawartości <c>p</c> albo pustego wpisu, w którym należy ją umieścić.
+ * Wymaga <c>PolyInternMutex</c>.
+ * @param p wielomian niebędący współczynnikiem, z internowanymi podwielomianami
+ * @param hash skrót <c>p</c>
+ * @return indeks wpisu
+ */
+static size_t PolyInternFind(const Poly *p, uint64_t hash)
+{
+    size_t mask = PolyInternCapacity - 1;
+    size_t i = hash & mask;
+    while (PolyInternTable[i].monos != NULL && !PolyInternMatches(PolyInternTable + i, p, hash))
+        i = (i + 1) & mask;
+    return i;
+}
+
+
+/**
+ * Zapewnia w tablicy internowania miejsce na jeszcze jeden wpis, podwajając ją, gdy jest zapełniona w połowie.
+ * Wymaga <c>PolyInternMutex</c>.
+ */
+static void PolyInternReserve(void)
+{
+    if (2 * (PolyInternCount + 1) <= PolyInternCapacity)
+        return;
+    PolyInternEntry *old = PolyInternTable;
+    size_t old_capacity = PolyInternCapacity;
+    PolyInternCapacity = old_capacity == 0 ? POLY_INTERN_INITIAL_CAPACITY : 2 * old_capacity;
+    PolyInternTable = calloc(PolyInternCapacity, sizeof(PolyInternEntry));
+    assert(PolyInternTable != NULL);
+    size_t mask = PolyInternCapacity - 1;
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old[i].monos == NULL)
+            continue;
+        size_t j = old[i].hash & mask;
+        while (PolyInternTable[j].monos != NULL)
+            j = (j + 1) & mask;
+        PolyInternTable[j] = old[i];
+    }
+    free(old);
+}
+
+
+/**
+ * Usuwa odwołanie do internowanej tablicy jednomianów; ostatnie odwołanie usuwa ją też z tablicy internowania, a
+ * opróżniona tablica internowania jest zwalniana.
+ * Licznik jest zmniejszany pod <c>PolyInternMutex</c>, żeby PolyIntern() nie znalazło tablicy w trakcie zwalniania.
+ * @param p wielomian z internowaną tablicą jednomianów
+ * @return czy było to ostatnie odwołanie (wtedy trzeba usunąć jednomiany i zwolnić tablicę)
+ */
+static bool PolyInternRelease(const Poly *p)
+{
+    pthread_mutex_lock(&PolyInternMutex);
+    bool last = atomic_fetch_sub_explicit(&PolyPoolHeader(p->monos)->references, 1, memory_order_acq_rel) == 1;
+    if (last) {
+        size_t mask = PolyInternCapacity - 1;
+        size_t hole = PolyInternHash(p) & mask;
+        while (PolyInternTable[hole].monos != p->monos)
+            hole = (hole + 1) & mask;
+        //Przesuwamy w tył kolejne wpisy, które mogą zajmować zwolnione miejsce, żeby nie zostawiać dziur w ciągach
+        for (size_t next = (hole + 1) & mask; PolyInternTable[next].monos != NULL; next = (next + 1) & mask) {
+            size_t home = PolyInternTable[next].hash & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                PolyInternTable[hole] = PolyInternTable[next];
+                hole = next;
+            }
+        }
+        PolyInternTable[hole].monos = NULL;
+        if (--PolyInternCount == 0) {
+            free(PolyInternTable);
+            PolyInternTable = NULL;
+            PolyInternCapacity = 0;
+        }
+    }
+    pthread_mutex_unlock(&PolyInternMutex);
+    return last;
+}
+
+
+void PolyDestroy(Poly *p)
+{
+    if (!PolyIsSmallCoeff(p)) {
+        if (p->length < 0) {
+            if (--((BigCoeff *)p->monos)->references == 0)
+                free(p->monos);
+            return;
+        }
+        if (PolyPoolHeader(p->monos)->interned ? !PolyInternRelease(p) : !MonosRelease(p->monos))
+            return;
+        for (poly_exp_t i = 0; i < p->length; ++i)
+            MonoDestroy(p->monos + i);
+        MonosFree(p->monos);
+    }
+}
+
+
+/**
+ * Dodaje wielomiany z pominięciem pamięci podręcznej działań (wywołania rekurencyjne z niej korzystają).
+ * @param p wielomian
+ * @param q wielomian
+ * @return \f$ p + q \f$
+ */
+static inline Poly PolyAddUncached(const Poly *p, const Poly *q)
+{
+    if (PolyIsSmallCoeff(p) && PolyIsSmallCoeff(q) && !CoeffMaySpill())
+        return PolyFromCoeff(CoeffAdd(p->asCoef, q->asCoef));
+    if (PolyIsCoeff(p) && PolyIsCoeff(q))
+        return CoeffSum(p, q);
+
+    if (PolyIsCoeff(q))
+        return PolyAddPC(p, q);
+    if (PolyIsCoeff(p))
+        return PolyAddPC(q, p);
+    return PolyAddPP(p, q);
+}
+
+
+/**
+ * Mnoży wielomiany niebędące współczynnikami, zbierając iloczyny par jednomianów w tablicy gęstej indeksowanej
+ * wykładnikiem wyniku. Każdy iloczyn jest od razu dodawany do swojej pozycji, zamiast scalać kolejne sumy
+ * częściowe całego poziomu.
+ * @param p wielomian niebędący współczynnikiem
+ * @param q wielomian niebędący współczynnikiem
+ * @param span rozpiętość wykładników wyniku
+ * @return \f$ p * q \f$
+ */
+static Poly PolyMulDenseLevel(const Poly *p, const Poly *q, size_t span)
+{
+    poly_exp_t low = p->monos[0].exp + q->monos[0].exp;
+    Poly *sums = malloc(span * sizeof(Poly));
+    assert(sums != NULL);
+    for (size_t k = 0; k < span; ++k)
+        sums[k] = PolyZero();
+
+    for (poly_exp_t j = 0; j < q->length; ++j) {
+        if (PolyIsZero(&q->monos[j].p))
+            continue;
+        for (poly_exp_t i = 0; i < p->length; ++i) {
+            Poly product = PolyMul(&p->monos[i].p, &q->monos[j].p);
+            Poly *sum = sums + (p->monos[i].exp + q->monos[j].exp - low);
+            if (PolyIsZero(sum)) {
+                *sum = product;
+            } else {
+                Poly old_sum = *sum;
+                *sum = PolyAdd(&old_sum, &product);
+                PolyDestroy(&old_sum);
+                PolyDestroy(&product);
+            }
+        }
+    }
+
+    poly_exp_t length = 0;
+    for (size_t k = 0; k < span; ++k)
+        length += !PolyIsZero(sums + k);
+    if (length == 0) {
+        free(sums);
+        return PolyZero();
+    }
+    Poly result = {.monos = MonosAlloc((size_t)length), .length = 0};
+    assert(result.monos != NULL);
+    for (size_t k = 0; k < span; ++k) {
+        if (!PolyIsZero(sums + k))
+            result.monos[result.length++] = (Mono){.p = sums[k], .exp = low + (poly_exp_t)k};
+    }
+    free(sums);
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Mnoży wielomiany z pominięciem pamięci podręcznej działań (wywołania rekurencyjne z niej korzystają).
+ * @param p wielomian
+ * @param q wielomian
+ * @return \f$ p * q \f$
+ */
+static Poly PolyMulUncached(const Poly *p, const Poly *q)
+{
+    if (PolyIsCoeff(q)) {
+        if (PolyIsZero(q))
+            return PolyZero();
+        Poly result = PolyClone(p);
+        PolyScaleByCoeff(&result, q);
+#ifdef WILL_RUN_ILL_TESTS
+        return PolySimplifyCoeff(result);
+#else
+        return result;
+#endif
+    }
+    //W innek kolenjości się zapętli
+    if (PolyIsCoeff(p))
+        return PolyMulUncached(q, p); //Także nie należy zapominać, że C nie jest funkcyjny: trzeba pisać return...
+
+    Poly product;
+    if (PolyIsLeaf(p) && PolyIsLeaf(q) && PolyMulLeaves(p, q, false, &product))
+        return product;
+
+    size_t products = (size_t)p->length * (size_t)q->length;
+    size_t span = (size_t)((int64_t)p->monos[p->length - 1].exp - p->monos[0].exp
+                           + q->monos[q->length - 1].exp - q->monos[0].exp) + 1;
+    if (span <= POLY_LEVEL_DENSE_FACTOR * products)
+        return PolyMulDenseLevel(p, q, span);
+
+    Poly fold = PolyZero();
+    for (poly_exp_t i = 0; i < q->length; ++i) {
+        if (PolyIsZero(&q->monos[i].p))
+            continue;
+        Poly old_fold = fold;
+        Poly next = PolyMulM(p, q->monos + i);
+        fold = PolyAdd(&old_fold, &next);
+        PolyDestroy(&old_fold);
+        PolyDestroy(&next);
+    }
+
+    return PolySimplifyCoeff(fold);
+}
+
+
+Poly PolyAddMonos(unsigned count, const Mono *monos)
+{
+    Mono *m_copy = MonosAlloc(count);
+    assert(m_copy != NULL);
+    for (poly_exp_t i = 0; i < (poly_exp_t )count; ++i)
+        m_copy[i] = monos[i];
+    return PolyFromMonos(m_copy, count);
+}
+
+
+Poly PolyAddCopiedMonos(unsigned count, const Mono *monos)
+{
+    Mono *m_copy = MonosAlloc(count);
+    assert(m_copy != NULL);
+    for (poly_exp_t i = 0; i < (poly_exp_t )count; ++i)
+        m_copy[i] = MonoClone(monos + i);
+    return PolyFromMonos(m_copy, count);
+}
+
+
+Poly PolyClone(const Poly *p)
+{
+    if (!PolyIsSmallCoeff(p)) {
+        if (p->length < 0)
+            ++((BigCoeff *)p->monos)->references;
+        else if (PolyPoolHeader(p->monos)->size_class != POLY_STATIC_SIZE_CLASS)
+            atomic_fetch_add_explicit(&PolyPoolHeader(p->monos)->references, 1, memory_order_relaxed);
+    }
+    return *p;
+}
+
+
+/**
+ * Internuje wielomian, przejmując go na własność. Tablice jednomianów, do których nie ma innych odwołań, są
+ * internowane w miejscu, bez kopiowania.
+ * @param p wielomian
+ * @return internowany wielomian równy <c>p</c> (lub <c>p</c>, gdy nie jest on w postaci kanonicznej)
+ */
+static Poly PolyInternOwned(Poly p)
+{
+    if (PolyIsCoeff(&p))
+        return p;
+    PolyPoolBlock *block = PolyPoolHeader(p.monos);
+    if (block->interned || block->size_class == POLY_ARENA_SIZE_CLASS)
+        return p;
+#ifndef POLY_USE_MALLOC
+    if (PolyArena.active)
+        return p;
+#endif
+
+    PolyMakeUnique(&p);
+    bool canonical = p.length > 1 || (p.length == 1 && (p.monos[0].exp != 0 || !PolyIsCoeff(&p.monos[0].p)));
+    for (poly_exp_t i = 0; i < p.length; ++i) {
+        p.monos[i].p = PolyInternOwned(p.monos[i].p);
+        const Poly *child = &p.monos[i].p;
+        canonical &= i == 0 || p.monos[i - 1].exp < p.monos[i].exp;
+        canonical &= PolyIsCoeff(child) ? !PolyIsZero(child) : PolyPoolHeader(child->monos)->interned;
+    }
+    //Tylko postać kanoniczna jest jednoznaczna; dzięki temu różne internowane tablice oznaczają różne wielomiany
+    if (!canonical)
+        return p;
+
+    uint64_t hash = PolyInternHash(&p);
+    pthread_mutex_lock(&PolyInternMutex);
+    PolyInternReserve();
+    size_t slot = PolyInternFind(&p, hash);
+    if (PolyInternTable[slot].monos != NULL) {
+        Poly found = {.monos = PolyInternTable[slot].monos, .length = p.length};
+        atomic_fetch_add_explicit(&PolyPoolHeader(found.monos)->references, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&PolyInternMutex);
+        PolyDestroy(&p);
+        return found;
+    }
+    PolyInternTable[slot] = (PolyInternEntry){.monos = p.monos, .length = p.length, .hash = hash};
+    ++PolyInternCount;
+    PolyPoolHeader(p.monos)->interned = true;
+    pthread_mutex_unlock(&PolyInternMutex);
+    return p;
+}
+
+
+Poly PolyIntern(const Poly *p)
+{
+    return PolyInternOwned(PolyClone(p));
+}
+
+
+/**
+ * Działanie, którego wyniki są przechowywane w pamięci podręcznej działań.
+ */
+typedef enum
+{
+    POLY_CACHE_ADD,
+    POLY_CACHE_MUL,
+    POLY_CACHE_POW,
+} PolyCacheOp;
+
+
+/**
+ * Klucz pamięci podręcznej działań. Argumenty są internowane, więc wystarczy porównywać adresy ich tablic
+ * jednomianów; wynik zależy też od arytmetyki współczynników.
+ */
+typedef struct
+{
+    ///Pierwszy argument (nie trzyma odwołania, dopóki klucz nie trafi do wpisu)
+    Poly p;
+
+    ///Drugi argument; zero dla <c>POLY_CACHE_POW</c>
+    Poly q;
+
+    ///Moduł arytmetyki współczynników
+    uint64_t modulus;
+
+    ///Skrót klucza
+    uint64_t hash;
+
+    ///Wykładnik dla <c>POLY_CACHE_POW</c>; 0 dla pozostałych działań
+    poly_exp_t exp;
+
+    ///Działanie
+    PolyCacheOp op;
+
+    ///Czy arytmetyka jest dokładna (PolySetExactCoefficients())
+    bool exact;
+
+    ///Czy wynik działania może trafić do pamięci podręcznej
+    bool active;
+} PolyCacheKey;
+
+
+/**
+ * Wpis pamięci podręcznej działań.
+ */
+typedef struct PolyCacheEntry
+{
+    ///Klucz; trzyma odwołania do argumentów, więc ich adresy nie mogą zostać użyte ponownie
+    PolyCacheKey key;
+
+    ///Internowany wynik działania
+    Poly result;
+
+    ///Pamięć przypisana wpisowi (z wynikiem)
+    size_t bytes;
+
+    ///Następny wpis w tym samym kubełku
+    struct PolyCacheEntry *chain;
+
+    ///Wpis użyty później; <c>NULL</c> dla ostatnio użytego
+    struct PolyCacheEntry *newer;
+
+    ///Wpis użyty wcześniej; <c>NULL</c> dla najdawniej użytego
+    struct PolyCacheEntry *older;
+} PolyCacheEntry;
+
+///Kubełki tablicy mieszającej pamięci podręcznej działań
+static PolyCacheEntry **PolyCacheBuckets = NULL;
+
+///Liczba kubełków <c>PolyCacheBuckets</c> (potęga dwójki)
+static size_t PolyCacheBucketCount = 0;
+
+///Statystyki pamięci podręcznej działań
+static PolyCacheStats PolyCache = {0, 0, 0, 0};
+
+///Budżet pamięci podręcznej działań w bajtach (PolySetCacheBudget())
+static atomic_size_t PolyCacheBudget = POLY_CACHE_DEFAULT_BUDGET;
+
+///Ostatnio użyty wpis
+static PolyCacheEntry *PolyCacheNewest = NULL;
+
+///Najdawniej użyty wpis, usuwany jako pierwszy po przekroczeniu budżetu
+static PolyCacheEntry *PolyCacheOldest = NULL;
+
+///Chroni pamięć podręczną działań
+static pthread_mutex_t PolyCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * Sprawdza, czy wielomian może być argumentem klucza pamięci podręcznej działań: czy jest małym współczynnikiem
+ * albo ma internowaną tablicę jednomianów.
+ * @param p wielomian
+ * @return czy wielomian jest identyfikowany przez swoją reprezentację
+ */
+static inline bool PolyCacheIsKey(const Poly *p)
+{
+    return PolyIsSmallCoeff(p) || (p->length >= 0 && PolyPoolHeader(p->monos)->interned);
+}
+
+
+/**
+ * Miesza reprezentację wielomianu: adres tablicy jednomianów albo wartość współczynnika.
+ * @param p wielomian spełniający PolyCacheIsKey()
+ * @return liczba do skrótu
+ */
+static inline uint64_t PolyCacheWord(const Poly *p)
+{
+    return !PolyIsSmallCoeff(p) ? (uint64_t)(uintptr_t)p->monos : HashMix((uint64_t)p->asCoef);
+}
+
+
+/**
+ * Tworzy klucz pamięci podręcznej dla działania na argumentach. Klucz jest nieaktywny, gdy pamięć podręczna jest
+ * wyłączona lub omijana, gdy któryś argument nie jest internowany, w zakresie areny (wynik byłby w arenie) oraz dla
+ * działań tańszych od obsługi pamięci podręcznej.
+ * @param op działanie
+ * @param p pierwszy argument
+ * @param q drugi argument (zero dla <c>POLY_CACHE_POW</c>)
+ * @param exp wykładnik (0 dla działań innych niż <c>POLY_CACHE_POW</c>)
+ * @return klucz
+ */
+static PolyCacheKey PolyCacheKeyOf(PolyCacheOp op, const Poly *p, const Poly *q, poly_exp_t exp)
+{
+    PolyCacheKey key = {.op = op, .exp = exp, .active = false};
+    if (PolyCacheBypass || atomic_load_explicit(&PolyCacheBudget, memory_order_relaxed) == 0
+        || !PolyCacheIsKey(p) || !PolyCacheIsKey(q))
+        return key;
+#ifndef POLY_USE_MALLOC
+    if (PolyArena.active)
+        return key;
+#endif
+    poly_exp_t length = (PolyIsSmallCoeff(p) ? 0 : p->length) + (PolyIsSmallCoeff(q) ? 0 : q->length);
+    if (op != POLY_CACHE_POW && length < POLY_CACHE_MIN_LENGTH)
+        return key;
+
+    //Dodawanie i mnożenie są przemienne; współczynniki idą przed tablicami
+    uintptr_t p_word = PolyIsSmallCoeff(p) ? 0 : (uintptr_t)p->monos;
+    uintptr_t q_word = PolyIsSmallCoeff(q) ? 0 : (uintptr_t)q->monos;
+    bool swap = op != POLY_CACHE_POW && (p_word > q_word || (p_word == 0 && q_word == 0 && p->asCoef > q->asCoef));
+    key.p = swap ? *q : *p;
+    key.q = swap ? *p : *q;
+    key.modulus = PolyModular.modulus;
+    key.exact = PolyExactCoefficients;
+    key.hash = HashMix(POLY_HASH_SEED ^ PolyCacheWord(&key.p));
+    key.hash = HashMix(key.hash ^ PolyCacheWord(&key.q));
+    key.hash = HashMix(key.hash ^ key.modulus ^ ((uint64_t)(uint32_t)exp << 8 | (uint64_t)op << 1 | key.exact));
+    key.active = true;
+    return key;
+}
+
+
+/**
+ * Sprawdza, czy dwa wielomiany-argumenty kluczy mają tę samą reprezentację.
+ * @param p wielomian spełniający PolyCacheIsKey()
+ * @param q wielomian spełniający PolyCacheIsKey()
+ * @return czy <c>p</c> i <c>q</c> są tym samym wielomianem
+ */
+static inline bool PolyCacheSameKey(const Poly *p, const Poly *q)
+{
+    if (PolyIsSmallCoeff(p) || PolyIsSmallCoeff(q))
+        return PolyIsSmallCoeff(p) && PolyIsSmallCoeff(q) && p->asCoef == q->asCoef;
+    return p->monos == q->monos;
+}
+
+
+/**
+ * Szuka wpisu o danym kluczu. Wymaga <c>PolyCacheMutex</c>.
+ * @param key aktywny klucz
+ * @return wpis albo <c>NULL</c>
+ */
+static PolyCacheEntry *PolyCacheFindEntry(const PolyCacheKey *key)
+{
+    if (PolyCacheBucketCount == 0)
+        return NULL;
+    PolyCacheEntry *entry = PolyCacheBuckets[key->hash & (PolyCacheBucketCount - 1)];
+    while (entry != NULL && (entry->key.hash != key->hash || entry->key.op != key->op || entry->key.exp != key->exp
+                             || entry->key.modulus != key->modulus || entry->key.exact != key->exact
+                             || !PolyCacheSameKey(&entry->key.p, &key->p) || !PolyCacheSameKey(&entry->key.q, &key->q)))
+        entry = entry->chain;
+    return entry;
+}
+
+
+/**
+ * Odłącza wpis od listy LRU. Wymaga <c>PolyCacheMutex</c>.
+ * @param entry wpis
+ */
+static void PolyCacheUnlink(PolyCacheEntry *entry)
+{
+    if (entry->newer != NULL)
+        entry->newer->older = entry->older;
+    else
+        PolyCacheNewest = entry->older;
+    if (entry->older != NULL)
+        entry->older->newer = entry->newer;
+    else
+        PolyCacheOldest = entry->newer;
+}
+
+
+/**
+ * Wstawia wpis na początek listy LRU (jako ostatnio użyty). Wymaga <c>PolyCacheMutex</c>.
+ * @param entry wpis spoza listy
+ */
+static void PolyCachePushNewest(PolyCacheEntry *entry)
+{
+    entry->newer = NULL;
+    entry->older = PolyCacheNewest;
+    if (PolyCacheNewest != NULL)
+        PolyCacheNewest->newer = entry;
+    else
+        PolyCacheOldest = entry;
+    PolyCacheNewest = entry;
+}
+
+
+/**
+ * Usuwa wpis z pamięci podręcznej wraz z jego odwołaniami do wielomianów; po usunięciu ostatniego wpisu zwalnia też
+ * kubełki. Wymaga <c>PolyCacheMutex</c>.
+ * @param entry wpis
+ */
+static void PolyCacheRemove(PolyCacheEntry *entry)
+{
+    PolyCacheEntry **link = PolyCacheBuckets + (entry->key.hash & (PolyCacheBucketCount - 1));
+    while (*link != entry)
+        link = &(*link)->chain;
+    *link = entry->chain;
+    PolyCacheUnlink(entry);
+    PolyCache.bytes -= entry->bytes;
+    PolyDestroy(&entry->key.p);
+    PolyDestroy(&entry->key.q);
+    PolyDestroy(&entry->result);
+    free(entry);
+    if (--PolyCache.entries == 0) {
+        free(PolyCacheBuckets);
+        PolyCacheBuckets = NULL;
+        PolyCacheBucketCount = 0;
+    }
+}
+
+
+/**
+ * Usuwa najdawniej użyte wpisy, aż pamięć podręczna zmieści się w budżecie. Wymaga <c>PolyCacheMutex</c>.
+ */
+static void PolyCacheTrim(void)
+{
+    size_t budget = atomic_load_explicit(&PolyCacheBudget, memory_order_relaxed);
+    while (PolyCache.bytes > budget)
+        PolyCacheRemove(PolyCacheOldest);
+}
+
+
+/**
+ * Podwaja liczbę kubełków, gdy wpisów jest więcej niż kubełków. Wymaga <c>PolyCacheMutex</c>.
+ */
+static void PolyCacheReserve(void)
+{
+    if (PolyCache.entries < PolyCacheBucketCount)
+        return;
+    size_t old_count = PolyCacheBucketCount;
+    PolyCacheEntry **old = PolyCacheBuckets;
+    PolyCacheBucketCount = old_count == 0 ? POLY_CACHE_INITIAL_BUCKETS : 2 * old_count;
+    PolyCacheBuckets = calloc(PolyCacheBucketCount, sizeof(PolyCacheEntry *));
+    assert(PolyCacheBuckets != NULL);
+    for (size_t i = 0; i < old_count; ++i) {
+        for (PolyCacheEntry *entry = old[i], *next; entry != NULL; entry = next) {
+            next = entry->chain;
+            PolyCacheEntry **bucket = PolyCacheBuckets + (entry->key.hash & (PolyCacheBucketCount - 1));
+            entry->chain = *bucket;
+            *bucket = entry;
+        }
+    }
+    free(old);
+}
+
+
+/**
+ * Szacuje pamięć zajmowaną przez jednomiany wielomianu (współdzielone podwielomiany są liczone wielokrotnie).
+ * @param p wielomian
+ * @return liczba bajtów
+ */
+static size_t PolyCacheSize(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return PolyIsBigCoeff(p) ? sizeof(BigCoeff) + ((BigCoeff *)p->monos)->size * sizeof(uint64_t) : 0;
+    size_t bytes = sizeof(PolyPoolBlock) + (size_t)p->length * sizeof(Mono);
+    for (poly_exp_t i = 0; i < p->length; ++i)
+        bytes += PolyCacheSize(&p->monos[i].p);
+    return bytes;
+}
+
+
+/**
+ * Szuka wyniku działania w pamięci podręcznej.
+ * @param key klucz działania
+ * @param[out] out miejsce na kopię zapamiętanego wyniku
+ * @return czy wynik został znaleziony
+ */
+static bool PolyCacheFind(const PolyCacheKey *key, Poly *out)
+{
+    if (!key->active)
+        return false;
+    pthread_mutex_lock(&PolyCacheMutex);
+    PolyCacheEntry *entry = PolyCacheFindEntry(key);
+    if (entry != NULL) {
+        PolyCacheUnlink(entry);
+        PolyCachePushNewest(entry);
+        *out = PolyClone(&entry->result);
+        ++PolyCache.hits;
+    } else {
+        ++PolyCache.misses;
+    }
+    pthread_mutex_unlock(&PolyCacheMutex);
+    return entry != NULL;
+}
+
+
+/**
+ * Zapamiętuje wynik działania. Wynik jest internowany, żeby mógł być argumentem kolejnych zapamiętywanych działań.
+ * @param key klucz działania
+ * @param result wynik działania (przejmowany na własność)
+ * @return wynik równy <c>result</c>
+ */
+static Poly PolyCacheStore(const PolyCacheKey *key, Poly result)
+{
+    if (!key->active)
+        return result;
+    result = PolyInternOwned(result);
+    size_t bytes = sizeof(PolyCacheEntry) + PolyCacheSize(&result);
+
+    pthread_mutex_lock(&PolyCacheMutex);
+    if (bytes <= atomic_load_explicit(&PolyCacheBudget, memory_order_relaxed) && PolyCacheFindEntry(key) == NULL) {
+        PolyCacheReserve();
+        PolyCacheEntry *entry = malloc(sizeof(PolyCacheEntry));
+        assert(entry != NULL);
+        *entry = (PolyCacheEntry){.key = *key, .result = PolyClone(&result), .bytes = bytes};
+        entry->key.p = PolyClone(&key->p);
+        entry->key.q = PolyClone(&key->q);
+        PolyCacheEntry **bucket = PolyCacheBuckets + (key->hash & (PolyCacheBucketCount - 1));
+        entry->chain = *bucket;
+        *bucket = entry;
+        PolyCachePushNewest(entry);
+        ++PolyCache.entries;
+        PolyCache.bytes += bytes;
+        PolyCacheTrim();
+    }
+    pthread_mutex_unlock(&PolyCacheMutex);
+    return result;
+}
+
+
+void PolySetCacheBudget(size_t bytes)
+{
+    pthread_mutex_lock(&PolyCacheMutex);
+    atomic_store_explicit(&PolyCacheBudget, bytes, memory_order_relaxed);
+    PolyCacheTrim();
+    pthread_mutex_unlock(&PolyCacheMutex);
+}
+
+
+bool PolySetCacheBypass(bool bypass)
+{
+    bool previous = PolyCacheBypass;
+    PolyCacheBypass = bypass;
+    return previous;
+}
+
+
+void PolyCacheClear(void)
+{
+    pthread_mutex_lock(&PolyCacheMutex);
+    while (PolyCacheOldest != NULL)
+        PolyCacheRemove(PolyCacheOldest);
+    pthread_mutex_unlock(&PolyCacheMutex);
+}
+
+
+PolyCacheStats PolyGetCacheStats(void)
+{
+    pthread_mutex_lock(&PolyCacheMutex);
+    PolyCacheStats stats = PolyCache;
+    pthread_mutex_unlock(&PolyCacheMutex);
+    return stats;
+}
+
+
+/**
+ * Wykonuje PolyAdd() lub PolyMul() na internowanych argumentach, korzystając z pamięci podręcznej działań.
+ * @param op <c>POLY_CACHE_ADD</c> albo <c>POLY_CACHE_MUL</c>
+ * @param p wielomian spełniający PolyCacheIsKey()
+ * @param q wielomian spełniający PolyCacheIsKey()
+ * @return wynik działania
+ */
+static Poly PolyCachedBinary(PolyCacheOp op, const Poly *p, const Poly *q)
+{
+    Poly result;
+    PolyCacheKey key = PolyCacheKeyOf(op, p, q, 0);
+    if (PolyCacheFind(&key, &result))
+        return result;
+    return PolyCacheStore(&key, op == POLY_CACHE_ADD ? PolyAddUncached(p, q) : PolyMulUncached(p, q));
+}
+
+
+Poly PolyAdd(const Poly *p, const Poly *q)
+{
+    //Najczęstsze przypadki (argumenty nieinternowane) nie płacą za obsługę pamięci podręcznej
+    if ((PolyIsSmallCoeff(p) && PolyIsSmallCoeff(q)) || !PolyCacheIsKey(p) || !PolyCacheIsKey(q))
+        return PolyAddUncached(p, q);
+    return PolyCachedBinary(POLY_CACHE_ADD, p, q);
+}
+
+
+Poly PolyMul(const Poly *p, const Poly *q)
+{
+    if ((PolyIsSmallCoeff(p) && PolyIsSmallCoeff(q)) || !PolyCacheIsKey(p) || !PolyCacheIsKey(q))
+        return PolyMulUncached(p, q);
+    return PolyCachedBinary(POLY_CACHE_MUL, p, q);
+}
+
+
+Poly PolyReduce(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return CoeffReduced(p);
+
+    Poly result;
+    result.monos = MonosAlloc(p->length);
+    assert(result.monos != NULL);
+    result.length = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        Poly child = PolyReduce(&p->monos[i].p);
+        if (!PolyIsZero(&child))
+            result.monos[result.length++] = (Mono){.p = child, .exp = p->monos[i].exp};
+    }
+
+    if (result.length == 0) {
+        MonosFree(result.monos);
+        return PolyZero();
+    }
+    return PolySimplifyCoeff(result);
+}
+
+
+Poly PolyNeg(const Poly *p)
+{
+    Poly result;
+    if (PolyIsCoeff(p)) {
+        result = CoeffNegation(p);
+    } else {
+        result.monos = MonosAlloc(p->length);
+        assert(result.monos != NULL);
+        result.length = p->length;
+        for (poly_exp_t i = 0; i < result.length; ++i) {
+            result.monos[i].exp = p->monos[i].exp;
+            result.monos[i].p = PolyNeg(&p->monos[i].p);
+        }
+    }
+    return result;
+}
+
+
+Poly PolySub(const Poly *p, const Poly *q)
+{
+    Poly q_neg = PolyNeg(q);
+    Poly result = PolyAdd(p, &q_neg);
+    PolyDestroy(&q_neg);
+    return PolySimplifyCoeff(result);
+}
+
+
+poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx)
+{
+    if (PolyIsZero(p))
+        return -1;
+    if (PolyIsCoeff(p))
+        return 0;
+
+    if (var_idx == 0) {
+        for (poly_exp_t i = p->length - 1; i >= 0; --i) {
+            if (!PolyIsZero(&p->monos[i].p))
+                return p->monos[i].exp;
+        }
+        assert(false);
+    }
+
+    poly_exp_t max = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        poly_exp_t ith_deg = PolyDegBy(&p->monos[i].p, var_idx - 1);
+        max = max > ith_deg ? max : ith_deg;
+    }
+    return max;
+}
+
+
+poly_exp_t PolyDeg(const Poly *p)
+{
+    if (PolyIsZero(p))
+        return -1;
+    if (PolyIsCoeff(p))
+        return 0;
+
+    poly_exp_t max = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (PolyIsZero(&p->monos[i].p))
+            continue;
+        poly_exp_t ith_deg = PolyDeg(&p->monos[i].p) + p->monos[i].exp;
+        max = max > ith_deg ? max : ith_deg;
+    }
+
+    return max;
+}
+
+
+/**
+ * Porównuje wielomian is współczynnik.
+ * Sprawdza czy wielomian <c>p</c>, który nie jest współczynnikiem, jest równy wielomianowi <c>q</c>,
+ * który jest współczynnikiem.
+ * @param p wielomian-nie-współczynnik
+ * @param q wielomian-współczynnik
+ * @return <c>true</c> gdy <c>p == q</c>, a <c>false</c> w przeciwnym wypadku
+ */
+static bool PolyIsEqPC(const Poly *p, const Poly *q)
+{
+    assert(!PolyIsCoeff(p));
+    assert(PolyIsCoeff(q));
+    if (p->monos[0].exp != 0)
+        return false;
+    if (!PolyIsEq(&p->monos[0].p, q))
+        return false;
+    for (poly_exp_t i = 1; i < p->length; ++i) {
+        if (!PolyIsZero(&p->monos[i].p))
+            return false;
+    }
+    return true;
+}
+
+
+/**
+ * Porównuje liście jednym przejściem po ich tablicach, zestawiając współczynniki wprost zamiast wywoływać
+ * PolyIsEq() dla każdej pary jednomianów.
+ * @param p liść
+ * @param q liść
+ * @return czy \f$ p = q \f$
+ */
+static bool PolyIsEqLeaves(const Poly *p, const Poly *q)
+{
+    assert(PolyIsLeaf(p) && PolyIsLeaf(q));
+    const Mono *p_monos = p->monos, *q_monos = q->monos;
+    poly_exp_t i = 0, j = 0;
+    while (i < p->length && j < q->length) {
+        if (p_monos[i].exp < q_monos[j].exp) {
+            if (p_monos[i++].p.asCoef != 0)
+                return false;
+        } else if (p_monos[i].exp > q_monos[j].exp) {
+            if (q_monos[j++].p.asCoef != 0)
+                return false;
+        } else if (p_monos[i++].p.asCoef != q_monos[j++].p.asCoef) {
+            return false;
+        }
+    }
+
+    for (; i < p->length; ++i) {
+        if (p_monos[i].p.asCoef != 0)
+            return false;
+    }
+    for (; j < q->length; ++j) {
+        if (q_monos[j].p.asCoef != 0)
+            return false;
+    }
+    return true;
+}
+
+
+bool PolyIsEq(const Poly *p, const Poly *q)
+{
+    if (!PolyIsCoeff(p) && PolyIsCoeff(q))
+        return PolyIsEqPC(p, q);
+    if (PolyIsCoeff(p) && !PolyIsCoeff(q))
+        return PolyIsEqPC(q, p);
+    if (PolyIsCoeff(p))
+        return CoeffIsEq(p, q);
+    if (p->monos == q->monos)
+        return true;
+    if (PolyPoolHeader(p->monos)->interned && PolyPoolHeader(q->monos)->interned)
+        return false;
+    if (PolyIsLeaf(p) && PolyIsLeaf(q))
+        return PolyIsEqLeaves(p, q);
+
+    poly_exp_t i = 0, j = 0;
+    while (i < p->length && j < q->length) {
+        if (p->monos[i].exp < q->monos[j].exp) {
+            if (!PolyIsZero(&p->monos[i].p))
+                return false;
+            ++i;
+        } else if (p->monos[i].exp > q->monos[j].exp) {
+            if (!PolyIsZero(&q->monos[j].p))
+                return false;
+            ++j;
+        } else {
+            if (!PolyIsEq(&p->monos[i].p, &q->monos[j].p))
+                return false;
+            ++i, ++j;
+        }
+    }
+
+    for (; i < p->length; ++i) {
+        if (!PolyIsZero(&p->monos[i].p))
+            return false;
+    }
+    for (; j < q->length; ++j) {
+        if (!PolyIsZero(&q->monos[j].p))
+            return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Wylicza skrót postaci kanonicznej wielomianu, zgłaszając przy okazji, czy ta postać jest współczynnikiem.
+ * @param p wielomian
+ * @param is_coeff miejsce na informację, czy postać kanoniczna jest współczynnikiem
+ * @param is_zero miejsce na informację, czy postać kanoniczna jest zerem
+ * @return skrót wielomianu
+ */
+static uint64_t PolyHashCanonical(const Poly *p, bool *is_coeff, bool *is_zero)
+{
+    if (PolyIsBigCoeff(p)) {
+        uint64_t buffer;
+        CoeffDigits digits = CoeffGetDigits(p, &buffer);
+        uint64_t hash = HashMix(POLY_HASH_SEED + digits.negative);
+        for (uint32_t i = 0; i < digits.size; ++i)
+            hash = HashMix(hash ^ digits.limbs[i]);
+        *is_coeff = true;
+        *is_zero = false;
+        return hash;
+    }
+    if (PolyIsCoeff(p)) {
+        *is_coeff = true;
+        *is_zero = p->asCoef == 0;
+        return HashMix((uint64_t)p->asCoef);
+    }
+
+    uint64_t hash = POLY_HASH_SEED, first = 0;
+    poly_exp_t nonzero = 0, first_exp = 0;
+    bool first_is_coeff = false;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        bool child_is_coeff, child_is_zero;
+        uint64_t child = PolyHashCanonical(&p->monos[i].p, &child_is_coeff, &child_is_zero);
+        if (child_is_zero)
+            continue;
+        if (nonzero++ == 0) {
+            first = child;
+            first_exp = p->monos[i].exp;
+            first_is_coeff = child_is_coeff;
+        }
+        hash = HashMix(hash ^ HashMix(child + (uint64_t)p->monos[i].exp * POLY_HASH_SEED));
+    }
+
+    *is_zero = nonzero == 0;
+    *is_coeff = nonzero == 0 || (nonzero == 1 && first_exp == 0 && first_is_coeff);
+    if (nonzero == 0)
+        return HashMix(0);
+    return *is_coeff ? first : hash;
+}
+
+
+uint64_t PolyHash(const Poly *p)
+{
+    bool is_coeff, is_zero;
+    return PolyHashCanonical(p, &is_coeff, &is_zero);
+}
+
+
+/**
+ * Mnoży liczby modulo \f$ 2^{61} - 1 \f$.
+ * @param a czynnik mniejszy od modułu
+ * @param b czynnik mniejszy od modułu
+ * @return \f$ ab \bmod (2^{61} - 1) \f$
+ */
+static inline uint64_t MersenneMul(uint64_t a, uint64_t b)
+{
+    unsigned __int128 product = (unsigned __int128)a * b;
+    uint64_t result = ((uint64_t)product & POLY_PROBABLE_MODULUS) + (uint64_t)(product >> 61);
+    return result >= POLY_PROBABLE_MODULUS ? result - POLY_PROBABLE_MODULUS : result;
+}
+
+
+/**
+ * Dodaje liczby modulo \f$ 2^{61} - 1 \f$.
+ * @param a składnik mniejszy od modułu
+ * @param b składnik mniejszy od modułu
+ * @return \f$ (a + b) \bmod (2^{61} - 1) \f$
+ */
+static inline uint64_t MersenneAdd(uint64_t a, uint64_t b)
+{
+    uint64_t result = a + b;
+    return result >= POLY_PROBABLE_MODULUS ? result - POLY_PROBABLE_MODULUS : result;
+}
+
+
+/**
+ * Potęguje liczbę modulo \f$ 2^{61} - 1 \f$.
+ * @param base podstawa mniejsza od modułu
+ * @param exponent wykładnik (nieujemny)
+ * @return \f$ \text{base}^\text{exponent} \bmod (2^{61} - 1) \f$
+ */
+static uint64_t MersennePower(uint64_t base, poly_exp_t exponent)
+{
+    uint64_t result = 1;
+    for (; exponent > 0; exponent /= 2, base = MersenneMul(base, base)) {
+        if (exponent % 2 == 1)
+            result = MersenneMul(result, base);
+    }
+    return result;
+}
+
+
+/**
+ * Wartościuje wielomian modulo \f$ 2^{61} - 1 \f$ w punkcie wyznaczonym przez ziarno rundy.
+ * Zmienna o indeksie \f$ d \f$ dostaje wartość wyprowadzoną z ziarna i \f$ d \f$, więc punkt nie musi być
+ * przechowywany w pamięci. Współczynnik o wartości bezwzględnej \f$ |c| = 2^{32} h + l \f$ jest odwzorowywany na
+ * \f$ \pm(l + r h) \f$ dla losowego \f$ r \f$ (duże współczynniki tak samo, po 32 bity na potęgę \f$ r \f$), dzięki
+ * czemu różne współczynniki dają różne wartości z dużym prawdopodobieństwem, także gdy różnią się o wielokrotność
+ * modułu. Znak i wartość bezwzględna są kodowane tak samo w obu reprezentacjach, więc np. mały \f$ -2^{63} \f$ i
+ * duży \f$ 2^{63} \f$ dostają przeciwne wartości.
+ * @param p wielomian
+ * @param seed ziarno rundy
+ * @param depth indeks zmiennej głównej wielomianu
+ * @param mixer losowa wartość \f$ r \f$ rundy
+ * @return wartość wielomianu
+ */
+static uint64_t PolyEvaluateProbable(const Poly *p, uint64_t seed, unsigned depth, uint64_t mixer)
+{
+    if (PolyIsBigCoeff(p)) {
+        uint64_t buffer, value = 0;
+        CoeffDigits digits = CoeffGetDigits(p, &buffer);
+        for (uint32_t i = digits.size; i-- > 0;) {
+            value = MersenneAdd(MersenneMul(value, mixer), digits.limbs[i] >> 32);
+            value = MersenneAdd(MersenneMul(value, mixer), digits.limbs[i] & UINT32_MAX);
+        }
+        return digits.negative && value != 0 ? POLY_PROBABLE_MODULUS - value : value;
+    }
+    if (PolyIsCoeff(p)) {
+        uint64_t magnitude = p->asCoef < 0 ? -(uint64_t)p->asCoef : (uint64_t)p->asCoef;
+        uint64_t value = MersenneAdd(magnitude & UINT32_MAX, MersenneMul(mixer, magnitude >> 32));
+        return p->asCoef < 0 && value != 0 ? POLY_PROBABLE_MODULUS - value : value;
+    }
+
+    uint64_t x = HashMix(seed + (depth + 1) * POLY_HASH_SEED) % POLY_PROBABLE_MODULUS;
+    uint64_t accumulator = 0;
+    poly_exp_t previous_exp = p->monos[p->length - 1].exp;
+    for (poly_exp_t i = p->length - 1; i >= 0; --i) {
+        accumulator = MersenneMul(accumulator, MersennePower(x, previous_exp - p->monos[i].exp));
+        accumulator = MersenneAdd(accumulator, PolyEvaluateProbable(&p->monos[i].p, seed, depth + 1, mixer));
+        previous_exp = p->monos[i].exp;
+    }
+    return MersenneMul(accumulator, MersennePower(x, previous_exp));
+}
+
+
+bool PolyIsEqProbable(const Poly *p, const Poly *q, unsigned rounds)
+{
+    for (unsigned round = 0; round < rounds; ++round) {
+        uint64_t seed = HashMix(atomic_fetch_add(&PolyRandomCounter, 1) ^ HashMix((uint64_t)time(NULL)));
+        uint64_t mixer = HashMix(seed) % POLY_PROBABLE_MODULUS;
+        if (PolyEvaluateProbable(p, seed, 0, mixer) != PolyEvaluateProbable(q, seed, 0, mixer))
+            return false;
+    }
+    return true;
+}
+
+
+/**
+ * Wylicza wartość liścia w punkcie schematem Hornera, w arytmetyce <c>poly_coeff_t</c>. Przy prawie ciągłych
+ * wykładnikach kolejne kroki mnożą tylko przez <c>x</c>; luki między wykładnikami kosztują jedno szybkie potęgowanie.
+ * @param p liść (PolyIsLeaf())
+ * @param x zredukowany punkt
+ * @return \f$ p(x) \f$
+ */
+static poly_coeff_t PolyAtLeaf(const Poly *p, poly_coeff_t x)
+{
+    poly_coeff_t accumulator = 0;
+    poly_exp_t previous_exp = p->monos[p->length - 1].exp;
+    for (poly_exp_t i = p->length - 1; i >= 0; --i) {
+        poly_exp_t gap = previous_exp - p->monos[i].exp;
+        accumulator = CoeffMul(accumulator, gap == 1 ? x : QuickPower(x, gap));
+        accumulator = CoeffAdd(accumulator, p->monos[i].p.asCoef);
+        previous_exp = p->monos[i].exp;
+    }
+    return CoeffMul(accumulator, QuickPower(x, previous_exp));
+}
+
+
+Poly PolyAt(const Poly *p, poly_coeff_t x)
+{
+    if (PolyIsCoeff(p))
+        return PolyClone(p);
+    if (!CoeffMaySpill() && PolyIsLeaf(p))
+        return PolyFromCoeff(PolyAtLeaf(p, CoeffReduce(x)));
+    Poly base = PolyFromCoeff(CoeffReduce(x));
+    Poly result = PolyZero();
+
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        Poly old_result = result;
+        Poly power = CoeffMaySpill() ? CoeffPower(&base, p->monos[i].exp)
+                                     : PolyFromCoeff(QuickPower(base.asCoef, p->monos[i].exp));
+        Poly evaluated_mono = PolyMul(&p->monos[i].p, &power);
+        result = PolyAdd(&old_result, &evaluated_mono);
+
+        PolyDestroy(&old_result);
+        PolyDestroy(&evaluated_mono);
+        PolyDestroy(&power);
+    }
+
+    return result;
+}
+
+
+void PolyPrint(const Poly *p, FILE *stream)
+{
+    if (PolyIsBigCoeff(p)) {
+        CoeffPrintBig(p, stream);
+    } else if (PolyIsSmallCoeff(p)) {
+        fprintf(stream, "%lli", (long long int) p->asCoef);
+    } else {
+        bool prepend_plus = false;
+        for (poly_exp_t i = 0; i < p->length; ++i) {
+            if (PolyIsZero(&p->monos[i].p))
+                continue;
+            if (prepend_plus)
+                fputc('+', stream);
+            fputc('(', stream);
+            PolyPrint(&p->monos[i].p, stream);
+            fputc(',', stream);
+            fprintf(stream, "%lu", (long unsigned)p->monos[i].exp);
+            fputc(')', stream);
+            prepend_plus = true;
+        }
+    }
+}
+
+
+/**
+ * Wylicza górne ograniczenie liczby slotów postaci zamrożonej (bez pomijania zerowych jednomianów).
+ * @param p wielomian
+ * @return liczba slotów (0 dla współczynnika); <c>SIZE_MAX</c>, gdy wielomian ma duże współczynniki
+ */
+static size_t PolyFrozenBound(const Poly *p)
+{
+    if (PolyIsBigCoeff(p))
+        return SIZE_MAX;
+    if (PolyIsCoeff(p))
+        return 0;
+    size_t bound = 1 + (size_t)p->length;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        size_t child = PolyFrozenBound(&p->monos[i].p);
+        if (child == SIZE_MAX)
+            return SIZE_MAX;
+        bound += child;
+    }
+    return bound;
+}
+
+
+/**
+ * Dopisuje do bufora postać zamrożoną wielomianu: nagłówek, sloty jednomianów i (kolejno) podwielomiany.
+ * Zerowe jednomiany są pomijane, a podwielomiany zapisane za miejscem zarezerwowanym na pominięte jednomiany są
+ * przesuwane w dół; odległości wewnątrz nich są względne, więc poprawiać trzeba tylko sloty jednomianów.
+ * @param p wielomian bez dużych współczynników
+ * @param slots bufor o pojemności co najmniej PolyFrozenBound()
+ * @param[in,out] size liczba zajętych slotów bufora
+ * @param[out] coef wartość wielomianu, gdy jego postać kanoniczna jest współczynnikiem
+ * @return <c>false</c>, gdy postać kanoniczna jest współczynnikiem (wtedy bufor nie jest zmieniany)
+ */
+static bool PolyFreezeInto(const Poly *p, PolyFrozenSlot *slots, size_t *size, poly_coeff_t *coef)
+{
+    if (PolyIsCoeff(p)) {
+        *coef = p->asCoef;
+        return false;
+    }
+    size_t header = *size;
+    PolyFrozenSlot *monos = slots + header + 1;
+    *size += 1 + (size_t)p->length;
+    poly_exp_t length = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        size_t child = *size;
+        poly_coeff_t child_coef;
+        if (PolyFreezeInto(&p->monos[i].p, slots, size, &child_coef)) {
+            uint32_t offset = (uint32_t)(child - (header + 1 + (size_t)length));
+            monos[length++] = (PolyFrozenSlot){.coef = 0, .exp = p->monos[i].exp, .child = offset};
+        } else if (child_coef != 0) {
+            monos[length++] = (PolyFrozenSlot){.coef = child_coef, .exp = p->monos[i].exp, .child = 0};
+        }
+    }
+
+    if (length == 0 || (length == 1 && monos[0].exp == 0 && monos[0].child == 0)) {
+        *coef = length == 0 ? 0 : monos[0].coef;
+        *size = header;
+        return false;
+    }
+    size_t gap = (size_t)(p->length - length);
+    if (gap > 0) {
+        size_t tail = header + 1 + (size_t)p->length;
+        memmove(monos + length, slots + tail, (*size - tail) * sizeof(PolyFrozenSlot));
+        *size -= gap;
+        for (poly_exp_t i = 0; i < length; ++i) {
+            if (monos[i].child != 0)
+                monos[i].child -= (uint32_t)gap;
+        }
+    }
+    slots[header] = (PolyFrozenSlot){.coef = 0, .exp = length, .child = 0};
+    return true;
+}
+
+
+bool PolyFreeze(const Poly *p, PolyFrozen *out)
+{
+    size_t bound = PolyFrozenBound(p);
+    if (bound == SIZE_MAX)
+        return false;
+    if (bound == 0) {
+        *out = (PolyFrozen){.slots = NULL, .coef = p->asCoef};
+        return true;
+    }
+    assert(bound <= UINT32_MAX);
+
+    PolyFrozenSlot *slots = malloc(bound * sizeof(PolyFrozenSlot));
+    assert(slots != NULL);
+    size_t size = 0;
+    poly_coeff_t coef;
+    if (!PolyFreezeInto(p, slots, &size, &coef)) {
+        free(slots);
+        *out = (PolyFrozen){.slots = NULL, .coef = coef};
+        return true;
+    }
+    if (size < bound) {
+        slots = realloc(slots, size * sizeof(PolyFrozenSlot));
+        assert(slots != NULL);
+    }
+    *out = (PolyFrozen){.slots = slots, .size = size};
+    return true;
+}
+
+
+/**
+ * Odtwarza wielomian z postaci zamrożonej zaczynającej się od nagłówka.
+ * @param header slot nagłówka
+ * @return wielomian
+ */
+static Poly PolyThawAt(const PolyFrozenSlot *header)
+{
+    Poly result = {.monos = MonosAlloc((size_t)header->exp), .length = header->exp};
+    assert(result.monos != NULL);
+    for (poly_exp_t i = 0; i < header->exp; ++i) {
+        const PolyFrozenSlot *mono = header + 1 + i;
+        Poly child = mono->child != 0 ? PolyThawAt(mono + mono->child) : PolyFromCoeff(mono->coef);
+        result.monos[i] = (Mono){.p = child, .exp = mono->exp};
+    }
+    return result;
+}
+
+
+Poly PolyThaw(const PolyFrozen *f)
+{
+    return f->slots == NULL ? PolyFromCoeff(f->coef) : PolyThawAt(f->slots);
+}
+
+
+PolyFrozen PolyFrozenClone(const PolyFrozen *f)
+{
+    if (f->slots == NULL)
+        return *f;
+    PolyFrozen result = {.slots = malloc(f->size * sizeof(PolyFrozenSlot)), .size = f->size};
+    assert(result.slots != NULL);
+    memcpy(result.slots, f->slots, f->size * sizeof(PolyFrozenSlot));
+    return result;
+}
+
+
+void PolyFrozenDestroy(PolyFrozen *f)
+{
+    free(f->slots);
+}
+
+
+bool PolyFrozenIsEq(const PolyFrozen *p, const PolyFrozen *q)
+{
+    if (p->slots == NULL || q->slots == NULL)
+        return p->slots == q->slots && p->coef == q->coef;
+    return p->size == q->size && memcmp(p->slots, q->slots, p->size * sizeof(PolyFrozenSlot)) == 0;
+}
+
+
+/**
+ * Wylicza skrót postaci zamrożonej zaczynającej się od nagłówka tak jak PolyHashCanonical().
+ * @param header slot nagłówka
+ * @return skrót
+ */
+static uint64_t PolyFrozenHashAt(const PolyFrozenSlot *header)
+{
+    uint64_t hash = POLY_HASH_SEED;
+    for (poly_exp_t i = 0; i < header->exp; ++i) {
+        const PolyFrozenSlot *mono = header + 1 + i;
+        uint64_t child = mono->child != 0 ? PolyFrozenHashAt(mono + mono->child) : HashMix((uint64_t)mono->coef);
+        hash = HashMix(hash ^ HashMix(child + (uint64_t)mono->exp * POLY_HASH_SEED));
+    }
+    return hash;
+}
+
+
+uint64_t PolyFrozenHash(const PolyFrozen *f)
+{
+    return f->slots == NULL ? HashMix((uint64_t)f->coef) : PolyFrozenHashAt(f->slots);
+}
+
+
+/**
+ * Zwraca stopień postaci zamrożonej zaczynającej się od nagłówka.
+ * @param header slot nagłówka
+ * @return stopień
+ */
+static poly_exp_t PolyFrozenDegAt(const PolyFrozenSlot *header)
+{
+    poly_exp_t max = 0;
+    for (poly_exp_t i = 0; i < header->exp; ++i) {
+        const PolyFrozenSlot *mono = header + 1 + i;
+        poly_exp_t ith_deg = mono->exp + (mono->child != 0 ? PolyFrozenDegAt(mono + mono->child) : 0);
+        max = max > ith_deg ? max : ith_deg;
+    }
+    return max;
+}
+
+
+poly_exp_t PolyFrozenDeg(const PolyFrozen *f)
+{
+    if (f->slots == NULL)
+        return f->coef == 0 ? -1 : 0;
+    return PolyFrozenDegAt(f->slots);
+}
+
+
+/**
+ * Zwraca stopień postaci zamrożonej zaczynającej się od nagłówka ze względu na zmienną.
+ * @param header slot nagłówka
+ * @param var_idx indeks zmiennej
+ * @return stopień
+ */
+static poly_exp_t PolyFrozenDegByAt(const PolyFrozenSlot *header, unsigned var_idx)
+{
+    //Jednomiany są posortowane rosnąco według wykładników i żaden nie jest zerowy
+    if (var_idx == 0)
+        return header[header->exp].exp;
+
+    poly_exp_t max = 0;
+    for (poly_exp_t i = 0; i < header->exp; ++i) {
+        const PolyFrozenSlot *mono = header + 1 + i;
+        poly_exp_t ith_deg = mono->child != 0 ? PolyFrozenDegByAt(mono + mono->child, var_idx - 1) : 0;
+        max = max > ith_deg ? max : ith_deg;
+    }
+    return max;
+}
+
+
+poly_exp_t PolyFrozenDegBy(const PolyFrozen *f, unsigned var_idx)
+{
+    if (f->slots == NULL)
+        return f->coef == 0 ? -1 : 0;
+    return PolyFrozenDegByAt(f->slots, var_idx);
+}
+
+
+/**
+ * Wypisuje postać zamrożoną zaczynającą się od nagłówka.
+ * @param header slot nagłówka
+ * @param stream strumień wyjściowy
+ */
+static void PolyFrozenPrintAt(const PolyFrozenSlot *header, FILE *stream)
+{
+    for (poly_exp_t i = 0; i < header->exp; ++i) {
+        const PolyFrozenSlot *mono = header + 1 + i;
+        if (i > 0)
+            fputc('+', stream);
+        fputc('(', stream);
+        if (mono->child != 0)
+            PolyFrozenPrintAt(mono + mono->child, stream);
+        else
+            fprintf(stream, "%lli", (long long int)mono->coef);
+        fputc(',', stream);
+        fprintf(stream, "%lu", (long unsigned)mono->exp);
+        fputc(')', stream);
+    }
+}
+
+
+void PolyFrozenPrint(const PolyFrozen *f, FILE *stream)
+{
+    if (f->slots == NULL)
+        fprintf(stream, "%lli", (long long int)f->coef);
+    else
+        PolyFrozenPrintAt(f->slots, stream);
+}
+
+
+/**
+ * Potęgowanie wielomianów przez podnoszenie do kwadratu.
+ * Dla podanego wielomianu \f$ p \f$ zwraca \f$ p^\text{exp} \f$. Implementacja nie jest ogonowa, gdyż nie
+ * i tak potrzebujemy dużo pamięci na wynik.
+ * @param p potęgowany wielomian
+ * @param exp wykładnik (człkowity, nieujemny)
+ * @return wielomian \f$ p^\text{exp} \f$
+ */
+static Poly PolyPowSquaring(const Poly *p, poly_exp_t exp)
+{
+    assert(exp >= 0);
+    if (exp == 0)
+        return PolyFromCoeff(1);
+    if (PolyIsZero(p))
+        return PolyZero();
+    if (exp == 1)
+        return PolyClone(p);
+
+    Poly root = PolyPowSquaring(p, exp / 2);
+    Poly result;
+    if (exp % 2 == 0) {
+        result = PolyMul(&root, &root);
+    } else {
+        Poly half_result = PolyMul(&root, &root);
+        result = PolyMul(&half_result, p);
+        PolyDestroy(&half_result);
+    }
+    PolyDestroy(&root);
+    return result;
+}
+
+
+/**
+ * Zwraca wyraz wolny wielomianu.
+ * Zwrócony wielomian jest współczynnikiem. Moze zostać zniszczony (wywołujący dostaje go na własność: wielomian
+ * jest alokowany przez tę funkcję).
+ * @param p odpytywany wielmian
+ * @return wyraz wolny wielomianu \f$ p \f$
+ */
+static Poly ExactCoefficient(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return PolyClone(p);
+    if (p->monos[0].exp == 0)
+        return ExactCoefficient(&p->monos[0].p);
+    return PolyZero();
+}
+
+
+/**
+ * Rekurencyjny krok przesunięcia Taylora metodą ,,dziel i zwyciężaj''.
+ * Fragment jednomianów o wykładnikach z przedziału \f$ [\text{low}, \text{low} + 2^\text{level}) \f$ traktujemy jako
+ * wielomian \f$ L + x_0^{h} H \f$, gdzie \f$ h = 2^{\text{level} - 1} \f$ (wykładniki są liczone względem
+ * <c>low</c>). Wtedy przesunięty fragment to \f$ L(x_0 + a) + (x_0 + a)^h H(x_0 + a) \f$.
+ * @param monos jednomiany fragmentu, posortowane rosnąco według wykładników
+ * @param length liczba jednomianów fragmentu
+ * @param low dolny kraniec przedziału wykładników
+ * @param level logarytm długości przedziału wykładników
+ * @param powers potęgi \f$ (x_0 + a)^{2^i} \f$ dla \f$ i < \text{level} \f$
+ * @return przesunięty fragment
+ */
+static Poly PolyShiftRange(const Mono *monos, poly_exp_t length, int64_t low, unsigned level, const Poly *powers)
+{
+    if (length == 0)
+        return PolyZero();
+    if (level == 0) {
+        assert(length == 1 && monos[0].exp == low);
+        Poly result;
+        result.length = 1;
+        result.monos = MonosAlloc(1);
+        assert(result.monos != NULL);
+        result.monos[0] = (Mono){.p = PolyClone(&monos[0].p), .exp = 0};
+        return PolySimplifyCoeff(result);
+    }
+
+    int64_t middle = low + ((int64_t)1 << (level - 1));
+    poly_exp_t split = 0;
+    while (split < length && monos[split].exp < middle)
+        ++split;
+
+    Poly lower = PolyShiftRange(monos, split, low, level - 1, powers);
+    Poly upper = PolyShiftRange(monos + split, length - split, middle, level - 1, powers);
+    if (PolyIsZero(&upper))
+        return lower;
+
+    Poly shifted_upper = PolyMul(&upper, powers + level - 1);
+    Poly result = PolyAdd(&lower, &shifted_upper);
+    PolyDestroy(&lower);
+    PolyDestroy(&upper);
+    PolyDestroy(&shifted_upper);
+    return result;
+}
+
+
+Poly PolyShift(const Poly *p, poly_coeff_t a)
+{
+    a = CoeffReduce(a);
+    if (PolyIsCoeff(p) || a == 0)
+        return PolyClone(p);
+
+    unsigned levels = 0;
+    while (((int64_t)1 << levels) <= p->monos[p->length - 1].exp)
+        ++levels;
+
+    Poly *powers = malloc(sizeof(Poly) * (levels + 1));
+    assert(powers != NULL);
+    for (unsigned i = 0; i < levels; ++i) {
+        if (i == 0) {
+            powers[0].length = 2;
+            powers[0].monos = MonosAlloc(2);
+            assert(powers[0].monos != NULL);
+            powers[0].monos[0] = (Mono){.p = PolyFromCoeff(a), .exp = 0};
+            powers[0].monos[1] = (Mono){.p = PolyFromCoeff(1), .exp = 1};
+        } else {
+            powers[i] = PolyMul(powers + i - 1, powers + i - 1);
+        }
+    }
+
+    Poly result = PolyShiftRange(p->monos, p->length, 0, levels, powers);
+
+    for (unsigned i = 0; i < levels; ++i)
+        PolyDestroy(powers + i);
+    free(powers);
+    return result;
+}
+
+
+/**
+ * Opis podstawienia w postaci jednomianu \f$ c \cdot x_\text{var}^\text{exp} \f$.
+ * Podstawienie stałe \f$ c \f$ jest opisywane przez <c>exp == 0</c> (wtedy <c>var</c> nie ma znaczenia).
+ */
+typedef struct
+{
+    ///Współczynnik jednomianu
+    poly_coeff_t coef;
+
+    ///Indeks zmiennej w jednomianie
+    unsigned var;
+
+    ///Wykładnik zmiennej w jednomianie
+    poly_exp_t exp;
+} MonoSubstitution;
+
+
+/**
+ * Spłaszczona lista wyrazów wielomianu.
+ * Każdy wyraz to współczynnik oraz wektor wykładników kolejnych zmiennych.
+ */
+typedef struct
+{
+    ///Liczba zmiennych (długość wektora wykładników każdego z wyrazów)
+    unsigned dims;
+
+    ///Liczba wyrazów na liście
+    size_t count;
+
+    ///Współczynniki wyrazów
+    poly_coeff_t *coefs;
+
+    ///Wykładniki wyrazów; wektor <c>i</c>-tego wyrazu zaczyna się od <c>exps[i * dims]</c>
+    poly_exp_t *exps;
+} PolyTermList;
+
+
+/**
+ * Sprawdza, czy wielomian jest jednomianem \f$ c \cdot x_j^k \f$ lub stałą i jeśli tak, to zapisuje jego opis.
+ * Jednomiany o zerowych współczynnikach są pomijane, więc niekanoniczne postaci wielomianu też zostaną rozpoznane.
+ * @param p badany wielomian
+ * @param out miejsce na opis podstawienia
+ * @return <c>true</c>, gdy wielomian ma oczekiwaną postać; <c>false</c> w.p.p.
+ */
+static bool PolyMatchMonomial(const Poly *p, MonoSubstitution *out)
+{
+    unsigned var = 0;
+    while (!PolyIsCoeff(p)) {
+        const Mono *found = NULL;
+        for (poly_exp_t i = 0; i < p->length; ++i) {
+            if (PolyIsZero(&p->monos[i].p))
+                continue;
+            if (found != NULL)
+                return false;
+            found = p->monos + i;
+        }
+
+        if (found == NULL) {
+            *out = (MonoSubstitution){.coef = 0, .var = 0, .exp = 0};
+            return true;
+        }
+        if (found->exp != 0) {
+            if (!PolyIsCoeff(&found->p))
+                return false;
+            *out = (MonoSubstitution){.coef = found->p.asCoef, .var = var, .exp = found->exp};
+            return true;
+        }
+        p = &found->p;
+        ++var;
+    }
+
+    *out = (MonoSubstitution){.coef = p->asCoef, .var = 0, .exp = 0};
+    return true;
+}
+
+
+/**
+ * Wylicza wartość wielomianu w punkcie o całkowitych współrzędnych (schematem Hornera na każdym poziomie).
+ * Zmienne o indeksach nie mniejszych niż <c>count</c> są zamieniane na 0.
+ * @param p wielomian
+ * @param count liczba zdefiniowanych współrzędnych punktu
+ * @param values współrzędne punktu
+ * @return \f$ p(\text{values[0]}, \ldots, \text{values[count - 1]}, 0, \ldots) \f$
+ */
+static poly_coeff_t PolyEvaluate(const Poly *p, poly_exp_t count, const poly_coeff_t *values)
+{
+    if (PolyIsCoeff(p))
+        return p->asCoef;
+    if (count == 0)
+        return ExactCoefficient(p).asCoef;
+
+    poly_coeff_t accumulator = 0;
+    poly_exp_t previous_exp = p->monos[p->length - 1].exp;
+    for (poly_exp_t i = p->length - 1; i >= 0; --i) {
+        accumulator = CoeffMul(accumulator, QuickPower(values[0], previous_exp - p->monos[i].exp));
+        accumulator = CoeffAdd(accumulator, PolyEvaluate(&p->monos[i].p, count - 1, values + 1));
+        previous_exp = p->monos[i].exp;
+    }
+    return CoeffMul(accumulator, QuickPower(values[0], previous_exp));
+}
+
+
+/**
+ * Zwraca górne ograniczenie na liczbę wyrazów wielomianu, w którym zmienne o indeksach co najmniej <c>count</c>
+ * zamieniono na 0.
+ * @param p wielomian
+ * @param count liczba rozpatrywanych zmiennych
+ * @return ograniczenie na liczbę wyrazów
+ */
+static size_t PolyCountTerms(const Poly *p, poly_exp_t count)
+{
+    if (PolyIsCoeff(p) || count == 0)
+        return 1;
+    size_t result = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i)
+        result += PolyCountTerms(&p->monos[i].p, count - 1);
+    return result;
+}
+
+
+/**
+ * Spłaszcza wielomian do listy wyrazów, wykonując po drodze jednomianowe podstawienia.
+ * Wyraz \f$ a \cdot x_0^{e_0} \cdots x_{n-1}^{e_{n-1}} \f$ przechodzi na pojedynczy wyraz
+ * \f$ a \prod c_i^{e_i} \cdot \prod x_{v_i}^{k_i e_i} \f$, więc żadne mnożenie wielomianów nie jest potrzebne.
+ * @param p spłaszczany wielomian
+ * @param count liczba pozostałych podstawień
+ * @param subs pozostałe podstawienia
+ * @param multiplier iloczyn współczynników podstawień z wyższych poziomów
+ * @param exps wektor wykładników zgromadzony na wyższych poziomach
+ * @param terms lista, do której dopisywane są wyrazy
+ */
+static void PolyFlattenTerms(const Poly *p, poly_exp_t count, const MonoSubstitution *subs,
+                             poly_coeff_t multiplier, poly_exp_t *exps, PolyTermList *terms)
+{
+    if (PolyIsCoeff(p) || count == 0) {
+        poly_coeff_t coef = CoeffMul(multiplier, ExactCoefficient(p).asCoef);
+        if (coef == 0)
+            return;
+        terms->coefs[terms->count] = coef;
+        memcpy(terms->exps + terms->count * terms->dims, exps, sizeof(poly_exp_t) * terms->dims);
+        ++terms->count;
+        return;
+    }
+
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        poly_coeff_t factor = QuickPower(subs[0].coef, p->monos[i].exp);
+        if (factor == 0)
+            continue;
+        poly_exp_t added = subs[0].exp * p->monos[i].exp;
+        if (subs[0].exp > 0)
+            exps[subs[0].var] += added;
+        PolyFlattenTerms(&p->monos[i].p, count - 1, subs + 1, CoeffMul(multiplier, factor), exps, terms);
+        if (subs[0].exp > 0)
+            exps[subs[0].var] -= added;
+    }
+}
+
+
+/**
+ * Porównuje leksykograficznie wektory wykładników dwóch wyrazów.
+ * @param terms lista wyrazów
+ * @param a indeks pierwszego wyrazu
+ * @param b indeks drugiego wyrazu
+ * @return liczbę ujemną, zero lub dodatnią, gdy wektor <c>a</c> jest odpowiednio mniejszy, równy lub większy od <c>b</c>
+ */
+static int PolyTermCompare(const PolyTermList *terms, size_t a, size_t b)
+{
+    const poly_exp_t *ea = terms->exps + a * terms->dims;
+    const poly_exp_t *eb = terms->exps + b * terms->dims;
+    for (unsigned d = 0; d < terms->dims; ++d) {
+        if (ea[d] != eb[d])
+            return ea[d] < eb[d] ? -1 : 1;
+    }
+    return 0;
+}
+
+
+/**
+ * Sortuje (wstępującym sortowaniem przez scalanie) indeksy wyrazów leksykograficznie według wektorów wykładników.
+ * @param terms lista wyrazów
+ * @param order tablica <c>terms->count</c> indeksów do posortowania
+ */
+static void PolySortTerms(const PolyTermList *terms, size_t *order)
+{
+    size_t *scratch = malloc(sizeof(size_t) * terms->count);
+    assert(scratch != NULL || terms->count == 0);
+
+    for (size_t width = 1; width < terms->count; width *= 2) {
+        for (size_t begin = 0; begin < terms->count; begin += 2 * width) {
+            size_t mid = begin + width < terms->count ? begin + width : terms->count;
+            size_t end = mid + width < terms->count ? mid + width : terms->count;
+            size_t i = begin, j = mid, k = begin;
+            while (i < mid && j < end)
+                scratch[k++] = PolyTermCompare(terms, order[j], order[i]) < 0 ? order[j++] : order[i++];
+            while (i < mid)
+                scratch[k++] = order[i++];
+            while (j < end)
+                scratch[k++] = order[j++];
+        }
+        memcpy(order, scratch, sizeof(size_t) * terms->count);
+    }
+
+    free(scratch);
+}
+
+
+/**
+ * Buduje wielomian z posortowanego fragmentu listy wyrazów.
+ * Wyrazy o równych wektorach wykładników są sumowane.
+ * @param terms lista wyrazów
+ * @param order posortowane indeksy wyrazów
+ * @param begin początek fragmentu
+ * @param end koniec fragmentu (za ostatnim wyrazem)
+ * @param level indeks zmiennej, według której budowany jest bieżący poziom
+ * @return wielomian będący sumą wyrazów fragmentu
+ */
+static Poly PolyFromSortedTerms(const PolyTermList *terms, const size_t *order, size_t begin, size_t end,
+                                unsigned level)
+{
+    if (level == terms->dims) {
+        poly_coeff_t sum = 0;
+        for (size_t i = begin; i < end; ++i)
+            sum = CoeffAdd(sum, terms->coefs[order[i]]);
+        return PolyFromCoeff(sum);
+    }
+
+#define TERM_EXP(i) (terms->exps[order[i] * terms->dims + level])
+    poly_exp_t groups = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (i == begin || TERM_EXP(i) != TERM_EXP(i - 1))
+            ++groups;
+    }
+    if (groups == 0)
+        return PolyZero();
+
+    Poly result;
+    result.monos = MonosAlloc(groups);
+    assert(result.monos != NULL);
+    result.length = 0;
+    for (size_t i = begin; i < end;) {
+        size_t j = i;
+        while (j < end && TERM_EXP(j) == TERM_EXP(i))
+            ++j;
+        Poly child = PolyFromSortedTerms(terms, order, i, j, level + 1);
+        if (!PolyIsZero(&child))
+            result.monos[result.length++] = (Mono){.p = child, .exp = TERM_EXP(i)};
+        i = j;
+    }
+#undef TERM_EXP
+
+    if (result.length == 0) {
+        MonosFree(result.monos);
+        return PolyZero();
+    }
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Kopiuje wielomian, zamieniając na 0 zmienne o indeksach nie mniejszych niż <c>count</c>.
+ * To jest wynik złożenia z podstawieniami tożsamościowymi \f$ x_i = x_i \f$.
+ * @param p kopiowany wielomian
+ * @param count liczba zachowywanych zmiennych
+ * @return skopiowany wielomian
+ */
+static Poly PolyCloneTruncated(const Poly *p, poly_exp_t count)
+{
+    if (PolyIsCoeff(p))
+        return PolyClone(p);
+    if (count == 0)
+        return ExactCoefficient(p);
+
+    Poly result;
+    result.monos = MonosAlloc(p->length);
+    assert(result.monos != NULL);
+    result.length = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        Poly child = PolyCloneTruncated(&p->monos[i].p, count - 1);
+        if (!PolyIsZero(&child))
+            result.monos[result.length++] = (Mono){.p = child, .exp = p->monos[i].exp};
+    }
+
+    if (result.length == 0) {
+        MonosFree(result.monos);
+        return PolyZero();
+    }
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Składa wielomian z podstawieniami, które są stałymi lub jednomianami \f$ c \cdot x_j^k \f$.
+ * Rozpoznaje trzy przypadki, w żadnym nie mnożąc wielomianów:
+ *   - same stałe: wynik jest liczony skalarnie przez PolyEvaluate()
+ *   - podstawienia tożsamościowe \f$ x_i = x_i \f$: wynik jest (obciętą) kopią wielomianu
+ *   - pozostałe jednomiany (w tym permutacje zmiennych): każdy wyraz przechodzi na jeden wyraz wyniku, zatem wystarczy
+ *     przeliczyć wykładniki i współczynniki, posortować wyrazy i odbudować z nich wielomian
+ * @param p składany wielomian; nie może być współczynnikiem
+ * @param count liczba podstawień
+ * @param subs podstawienia
+ * @param out miejsce na wynik
+ * @return <c>false</c>, gdy któreś z podstawień nie jest stałą ani jednomianem albo gdy współczynniki mogą wyjść poza
+ * <c>poly_coeff_t</c> (CoeffMaySpill()); wtedy <c>out</c> nie jest zmieniany
+ */
+static bool PolyComposeMonomials(const Poly *p, poly_exp_t count, const Poly *subs, Poly *out)
+{
+    if (CoeffMaySpill())
+        return false;
+
+    MonoSubstitution *shapes = malloc(sizeof(MonoSubstitution) * count);
+    assert(shapes != NULL);
+
+    bool all_const = true, identity = true;
+    unsigned dims = 0;
+    for (poly_exp_t i = 0; i < count; ++i) {
+        if (!PolyMatchMonomial(subs + i, shapes + i)) {
+            free(shapes);
+            return false;
+        }
+        if (shapes[i].exp > 0) {
+            all_const = false;
+            dims = dims > shapes[i].var + 1 ? dims : shapes[i].var + 1;
+        }
+        identity &= shapes[i].exp == 1 && shapes[i].coef == 1 && shapes[i].var == (unsigned)i;
+    }
+
+    if (identity) {
+        *out = PolyCloneTruncated(p, count);
+    } else if (all_const) {
+        poly_coeff_t *values = malloc(sizeof(poly_coeff_t) * count);
+        assert(values != NULL);
+        for (poly_exp_t i = 0; i < count; ++i)
+            values[i] = shapes[i].coef;
+        *out = PolyFromCoeff(PolyEvaluate(p, count, values));
+        free(values);
+    } else {
+        size_t capacity = PolyCountTerms(p, count);
+        PolyTermList terms = {.dims = dims, .count = 0};
+        terms.coefs = malloc(sizeof(poly_coeff_t) * capacity);
+        terms.exps = malloc(sizeof(poly_exp_t) * capacity * dims);
+        poly_exp_t *exps = calloc(dims, sizeof(poly_exp_t));
+        assert(terms.coefs != NULL && terms.exps != NULL && exps != NULL);
+
+        PolyFlattenTerms(p, count, shapes, 1, exps, &terms);
+        size_t *order = malloc(sizeof(size_t) * (terms.count + 1));
+        assert(order != NULL);
+        for (size_t i = 0; i < terms.count; ++i)
+            order[i] = i;
+        PolySortTerms(&terms, order);
+        *out = PolyFromSortedTerms(&terms, order, 0, terms.count, 0);
+
+        free(order);
+        free(exps);
+        free(terms.exps);
+        free(terms.coefs);
+    }
+
+    free(shapes);
+    return true;
+}
+
+
+/**
+ * Sprawdza, czy wielomian jest postaci \f$ x_0 + a \f$ dla pewnego \f$ a \neq 0 \f$.
+ * @param p badany wielomian
+ * @param a miejsce na wyraz wolny
+ * @return <c>true</c>, gdy wielomian ma oczekiwaną postać; <c>false</c> w.p.p.
+ */
+static bool PolyMatchLinearShift(const Poly *p, poly_coeff_t *a)
+{
+    if (PolyIsCoeff(p))
+        return false;
+
+    poly_coeff_t shift = 0;
+    bool linear = false;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        const Mono *m = p->monos + i;
+        if (PolyIsZero(&m->p))
+            continue;
+        if (!PolyIsCoeff(&m->p) || m->exp > 1)
+            return false;
+        if (m->exp == 0)
+            shift = m->p.asCoef;
+        else if (m->p.asCoef == 1)
+            linear = true;
+        else
+            return false;
+    }
+
+    *a = shift;
+    return linear && shift != 0;
+}
+
+
+/**
+ * Składa wielomian z podstawieniami \f$ x_0 = x_0 + a \f$ oraz \f$ x_i = x_i \f$ dla \f$ i > 0 \f$, używając
+ * PolyShift().
+ * @param p składany wielomian
+ * @param count liczba podstawień
+ * @param subs podstawienia
+ * @param out miejsce na wynik
+ * @return <c>false</c>, gdy podstawienia nie mają oczekiwanej postaci albo gdy współczynniki mogą wyjść poza
+ * <c>poly_coeff_t</c> (CoeffMaySpill()); wtedy <c>out</c> nie jest zmieniany
+ */
+static bool PolyComposeShift(const Poly *p, poly_exp_t count, const Poly *subs, Poly *out)
+{
+    if (CoeffMaySpill())
+        return false;
+
+    poly_coeff_t a;
+    if (!PolyMatchLinearShift(subs + 0, &a))
+        return false;
+    for (poly_exp_t i = 1; i < count; ++i) {
+        MonoSubstitution shape;
+        if (!PolyMatchMonomial(subs + i, &shape) || shape.coef != 1 || shape.exp != 1 || shape.var != (unsigned)i)
+            return false;
+    }
+
+    Poly truncated = PolyCloneTruncated(p, count);
+    *out = PolyShift(&truncated, a);
+    PolyDestroy(&truncated);
+    return true;
+}
+
+
+/**
+ * Szybkie potęgowanie z wykrywaniem przepełnienia.
+ * @param base podstawa
+ * @param exponent wykładnik (nieujemny)
+ * @param overflow ustawiane na <c>true</c>, gdy wynik nie mieści się w <c>poly_coeff_t</c>
+ * @return \f$ \text{base}^\text{exponent} \f$, o ile nie wystąpiło przepełnienie
+ */
+static poly_coeff_t QuickPowerChecked(poly_coeff_t base, poly_exp_t exponent, bool *overflow)
+{
+    poly_coeff_t result = 1;
+    while (exponent > 0) {
+        if (exponent % 2 == 1)
+            *overflow |= __builtin_mul_overflow(result, base, &result);
+        exponent /= 2;
+        if (exponent > 0)
+            *overflow |= __builtin_mul_overflow(base, base, &base);
+    }
+    return result;
+}
+
+
+/**
+ * Wersja PolyEvaluate() wykrywająca przepełnienie.
+ * @param p wielomian
+ * @param count liczba zdefiniowanych współrzędnych punktu
+ * @param values współrzędne punktu
+ * @param overflow ustawiane na <c>true</c>, gdy któreś z obliczeń nie mieści się w <c>poly_coeff_t</c>
+ * @return \f$ p(\text{values[0]}, \ldots, \text{values[count - 1]}, 0, \ldots) \f$, o ile nie wystąpiło przepełnienie
+ */
+static poly_coeff_t PolyEvaluateChecked(const Poly *p, poly_exp_t count, const poly_coeff_t *values, bool *overflow)
+{
+    if (PolyIsCoeff(p))
+        return p->asCoef;
+    if (count == 0)
+        return ExactCoefficient(p).asCoef;
+
+    poly_coeff_t accumulator = 0;
+    poly_exp_t previous_exp = p->monos[p->length - 1].exp;
+    for (poly_exp_t i = p->length - 1; i >= 0 && !*overflow; --i) {
+        poly_coeff_t power = QuickPowerChecked(values[0], previous_exp - p->monos[i].exp, overflow);
+        poly_coeff_t coef = PolyEvaluateChecked(&p->monos[i].p, count - 1, values + 1, overflow);
+        *overflow |= __builtin_mul_overflow(accumulator, power, &accumulator);
+        *overflow |= __builtin_add_overflow(accumulator, coef, &accumulator);
+        previous_exp = p->monos[i].exp;
+    }
+    poly_coeff_t power = QuickPowerChecked(values[0], previous_exp, overflow);
+    *overflow |= __builtin_mul_overflow(accumulator, power, &accumulator);
+    return accumulator;
+}
+
+
+/**
+ * Zwraca liczbę zmiennych, od których może zależeć wielomian (indeks najgłębszej zmiennej plus jeden).
+ * @param p wielomian
+ * @return liczba zmiennych
+ */
+static unsigned PolyVarCount(const Poly *p)
+{
+    if (PolyIsCoeff(p))
+        return 0;
+    unsigned result = 1;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (PolyIsZero(&p->monos[i].p))
+            continue;
+        unsigned nested = 1 + PolyVarCount(&p->monos[i].p);
+        result = result > nested ? result : nested;
+    }
+    return result;
+}
+
+
+/**
+ * Potęgowanie liczb zmiennoprzecinkowych, używane w szacowaniu kosztów.
+ * @param base podstawa
+ * @param exponent wykładnik (nieujemny)
+ * @return \f$ \text{base}^\text{exponent} \f$
+ */
+static double DoublePower(double base, poly_exp_t exponent)
+{
+    double result = 1;
+    for (; exponent > 0; exponent /= 2, base *= base) {
+        if (exponent % 2 == 1)
+            result *= base;
+    }
+    return result;
+}
+
+
+/**
+ * Dane interpolacyjnej wersji PolyCompose().
+ * Wynik jest szukany w postaci gęstej: tablica <c>values</c> zawiera wartości (a po interpolacji współczynniki)
+ * w punktach siatki \f$ \prod_j \{0, \ldots, \text{bound[j]}\} \f$; punkt \f$ (k_0, k_1, \ldots) \f$ ma indeks
+ * \f$ \sum_j k_j \cdot \text{stride[j]} \f$, a odpowiadający mu węzeł to \f$ x_j = k_j - \text{bound[j]} / 2 \f$.
+ */
+typedef struct
+{
+    ///Składany wielomian
+    const Poly *p;
+
+    ///Liczba podstawień
+    poly_exp_t count;
+
+    ///Podstawienia
+    const Poly *subs;
+
+    ///Liczba zmiennych wyniku
+    unsigned dims;
+
+    ///Ograniczenia stopnia wyniku względem kolejnych zmiennych
+    int64_t *bound;
+
+    ///Odległości w tablicy <c>values</c> pomiędzy sąsiednimi punktami wzdłuż kolejnych zmiennych
+    size_t *stride;
+
+    ///Liczba punktów siatki
+    size_t points;
+
+    ///Wartości w punktach siatki, a po interpolacji współczynniki wyniku
+    poly_coeff_t *values;
+
+    ///Zmienna, względem której trwa interpolacja
+    unsigned dim;
+
+    ///Ustawiane, gdy któreś z obliczeń przekroczyło zakres <c>poly_coeff_t</c>
+    atomic_bool overflow;
+} PolyInterpolationJob;
+
+
+/**
+ * Szacuje koszt symbolicznego składania oraz wyznacza ograniczenia stopnia wyniku względem kolejnych zmiennych.
+ * Koszt wyrazu \f$ a \prod x_i^{e_i} \f$ to liczba iloczynów w naiwnym rozwinięciu \f$ \prod \text{subs}_i^{e_i} \f$.
+ * @param p składany wielomian
+ * @param count liczba pozostałych podstawień
+ * @param sub_terms liczby wyrazów pozostałych podstawień
+ * @param sub_degs stopnie pozostałych podstawień względem kolejnych zmiennych (po <c>dims</c> na podstawienie)
+ * @param dims liczba zmiennych wyniku
+ * @param weight koszt zgromadzony na wyższych poziomach
+ * @param acc stopnie zgromadzone na wyższych poziomach
+ * @param bound ograniczenia stopni (aktualizowane)
+ * @return szacowany koszt
+ */
+static double PolyComposeEstimate(const Poly *p, poly_exp_t count, const size_t *sub_terms, const poly_exp_t *sub_degs,
+                                  unsigned dims, double weight, int64_t *acc, int64_t *bound)
+{
+    if (PolyIsCoeff(p) || count == 0) {
+        for (unsigned j = 0; j < dims; ++j)
+            bound[j] = bound[j] > acc[j] ? bound[j] : acc[j];
+        return weight;
+    }
+
+    double cost = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        poly_exp_t e = p->monos[i].exp;
+        for (unsigned j = 0; j < dims; ++j)
+            acc[j] += (int64_t)e * sub_degs[j];
+        cost += PolyComposeEstimate(&p->monos[i].p, count - 1, sub_terms + 1, sub_degs + dims, dims,
+                                    weight * DoublePower((double)sub_terms[0], e), acc, bound);
+        for (unsigned j = 0; j < dims; ++j)
+            acc[j] -= (int64_t)e * sub_degs[j];
+    }
+    return cost;
+}
+
+
+/**
+ * Oblicza wartości złożenia w jednym fragmencie punktów siatki.
+ * @param context wskaźnik na <c>PolyInterpolationJob</c>
+ * @param chunk indeks fragmentu
+ */
+static void PolyInterpolationEvaluateTask(void *context, size_t chunk)
+{
+    PolyInterpolationJob *job = context;
+    poly_coeff_t *point = malloc(sizeof(poly_coeff_t) * (job->dims + job->count));
+    assert(point != NULL);
+    poly_coeff_t *sub_values = point + job->dims;
+
+    size_t end = (chunk + 1) * POLY_INTERPOLATION_CHUNK;
+    end = end < job->points ? end : job->points;
+    bool overflow = false;
+    for (size_t index = chunk * POLY_INTERPOLATION_CHUNK; index < end && !overflow; ++index) {
+        for (unsigned j = 0; j < job->dims; ++j)
+            point[j] = (poly_coeff_t)((index / job->stride[j]) % (job->bound[j] + 1)) - job->bound[j] / 2;
+        for (poly_exp_t i = 0; i < job->count; ++i)
+            sub_values[i] = PolyEvaluateChecked(job->subs + i, job->dims, point, &overflow);
+        job->values[index] = PolyEvaluateChecked(job->p, job->count, sub_values, &overflow);
+    }
+
+    if (overflow)
+        atomic_store(&job->overflow, true);
+    free(point);
+}
+
+
+/**
+ * Interpoluje wielomian jednej zmiennej na węzłach \f$ z_k = k - n / 2 \f$ (postać Newtona zamieniana na zwykłą).
+ * Wszystkie dzielenia w ilorazach różnicowych są dokładne, bo interpolowany wielomian ma całkowite współczynniki.
+ * @param values wartości w kolejnych węzłach, zastępowane współczynnikami przy kolejnych potęgach zmiennej
+ * @param n stopień interpolowanego wielomianu
+ * @param overflow ustawiane na <c>true</c>, gdy obliczenia wyszły poza zakres <c>poly_coeff_t</c>
+ */
+static void PolyInterpolateLine(poly_coeff_t *values, int64_t n, bool *overflow)
+{
+    poly_coeff_t shift = n / 2;
+    for (int64_t k = 1; k <= n; ++k) {
+        for (int64_t i = n; i >= k; --i) {
+            poly_coeff_t difference;
+            *overflow |= __builtin_sub_overflow(values[i], values[i - 1], &difference);
+            if (difference % k != 0)
+                *overflow = true;
+            values[i] = difference / k;
+        }
+    }
+
+    //Schemat Hornera dla postaci Newtona: a = a * (x - z_k) + c_k, liczony w miejscu od najwyższych współczynników
+    for (int64_t k = n - 1; k >= 0; --k) {
+        poly_coeff_t node = k - shift;
+        for (int64_t d = k; d < n; ++d) {
+            poly_coeff_t product;
+            *overflow |= __builtin_mul_overflow(node, values[d + 1], &product);
+            *overflow |= __builtin_sub_overflow(values[d], product, values + d);
+        }
+    }
+}
+
+
+/**
+ * Interpoluje wartości wzdłuż jednej prostej siatki równoległej do osi zmiennej <c>job->dim</c>.
+ * @param context wskaźnik na <c>PolyInterpolationJob</c>
+ * @param line indeks prostej (numer punktu siatki z pominięciem współrzędnej <c>job->dim</c>)
+ */
+static void PolyInterpolationLineTask(void *context, size_t line)
+{
+    PolyInterpolationJob *job = context;
+    size_t stride = job->stride[job->dim];
+    int64_t n = job->bound[job->dim];
+    size_t first = (line / stride) * stride * (size_t)(n + 1) + line % stride;
+
+    poly_coeff_t *buffer = malloc(sizeof(poly_coeff_t) * (n + 1));
+    assert(buffer != NULL);
+    for (int64_t k = 0; k <= n; ++k)
+        buffer[k] = job->values[first + k * stride];
+    bool overflow = false;
+    PolyInterpolateLine(buffer, n, &overflow);
+    for (int64_t k = 0; k <= n; ++k)
+        job->values[first + k * stride] = buffer[k];
+    free(buffer);
+
+    if (overflow)
+        atomic_store(&job->overflow, true);
+}
+
+
+/**
+ * Buduje wielomian z gęstej tablicy współczynników.
+ * @param job dane interpolacji z obliczonymi współczynnikami
+ * @param level indeks zmiennej bieżącego poziomu
+ * @param offset indeks pierwszego współczynnika bieżącego fragmentu
+ * @return wielomian
+ */
+static Poly PolyFromDenseCoeffs(const PolyInterpolationJob *job, unsigned level, size_t offset)
+{
+    if (level == job->dims)
+        return PolyFromCoeff(job->values[offset]);
+
+    Poly result;
+    result.monos = MonosAlloc(job->bound[level] + 1);
+    assert(result.monos != NULL);
+    result.length = 0;
+    for (int64_t k = 0; k <= job->bound[level]; ++k) {
+        Poly child = PolyFromDenseCoeffs(job, level + 1, offset + k * job->stride[level]);
+        if (!PolyIsZero(&child))
+            result.monos[result.length++] = (Mono){.p = child, .exp = (poly_exp_t)k};
+    }
+
+    if (result.length == 0) {
+        MonosFree(result.monos);
+        return PolyZero();
+    }
+    return PolySimplifyCoeff(result);
+}
+
+
+/**
+ * Składa wielomiany metodą ewaluacji i interpolacji.
+ * Stopień wyniku względem każdej zmiennej jest ograniczany przy pomocy PolyDegBy() podstawień; wynik jest obliczany
+ * (skalarnie, z wykrywaniem przepełnień) w punktach odpowiednio dużej siatki liczb całkowitych, a następnie
+ * interpolowany kolejno względem każdej zmiennej. Metoda jest używana tylko wtedy, gdy model kosztów przewiduje zysk
+ * względem składania symbolicznego, które przy gęstych podstawieniach wielu zmiennych produkuje ogromne wyniki
+ * pośrednie. W arytmetyce modularnej (PolySetModulus()) i dokładnej (PolySetExactCoefficients()) metoda nie jest
+ * używana.
+ * @param p składany wielomian; nie może być współczynnikiem
+ * @param count liczba podstawień
+ * @param subs podstawienia
+ * @param out miejsce na wynik
+ * @return <c>false</c>, gdy metoda się nie opłaca lub wystąpiło przepełnienie (wtedy <c>out</c> nie jest zmieniany)
+ */
+static bool PolyComposeInterpolation(const Poly *p, poly_exp_t count, const Poly *subs, Poly *out)
+{
+    if (PolyModular.modulus != 0 || PolyExactCoefficients)
+        return false;
+
+    PolyInterpolationJob job = {.p = p, .count = count, .subs = subs, .dims = 0};
+    for (poly_exp_t i = 0; i < count; ++i) {
+        unsigned vars = PolyVarCount(subs + i);
+        job.dims = job.dims > vars ? job.dims : vars;
+    }
+    if (job.dims == 0)
+        return false;
+
+    size_t *sub_terms = malloc(sizeof(size_t) * count);
+    poly_exp_t *sub_degs = malloc(sizeof(poly_exp_t) * count * job.dims);
+    int64_t *acc = calloc(job.dims, sizeof(int64_t));
+    job.bound = calloc(job.dims, sizeof(int64_t));
+    job.stride = malloc(sizeof(size_t) * job.dims);
+    assert(sub_terms != NULL && sub_degs != NULL && acc != NULL && job.bound != NULL && job.stride != NULL);
+
+    double sub_cost = 0;
+    for (poly_exp_t i = 0; i < count; ++i) {
+        sub_terms[i] = PolyCountTerms(subs + i, INT32_MAX);
+        sub_cost += sub_terms[i];
+        for (unsigned j = 0; j < job.dims; ++j) {
+            poly_exp_t deg = PolyDegBy(subs + i, j);
+            sub_degs[i * job.dims + j] = deg > 0 ? deg : 0;
+        }
+    }
+    double symbolic_cost = PolyComposeEstimate(p, count, sub_terms, sub_degs, job.dims, 1, acc, job.bound);
+
+    double points = 1;
+    for (unsigned j = job.dims; j-- > 0;) {
+        job.stride[j] = (size_t)points;
+        points *= (double)(job.bound[j] + 1);
+    }
+    double interpolation_cost = points * ((double)PolyCountTerms(p, count) + sub_cost + job.dims);
+
+    bool result = false;
+    if (points <= POLY_INTERPOLATION_MAX_POINTS
+        && interpolation_cost * POLY_INTERPOLATION_COST_FACTOR < symbolic_cost) {
+        job.points = (size_t)points;
+        job.values = malloc(sizeof(poly_coeff_t) * job.points);
+        assert(job.values != NULL);
+        atomic_init(&job.overflow, false);
+
+        PolyParallelFor((job.points + POLY_INTERPOLATION_CHUNK - 1) / POLY_INTERPOLATION_CHUNK,
+                        PolyInterpolationEvaluateTask, &job);
+        for (job.dim = 0; job.dim < job.dims && !atomic_load(&job.overflow); ++job.dim)
+            PolyParallelFor(job.points / (size_t)(job.bound[job.dim] + 1), PolyInterpolationLineTask, &job);
+
+        if (!atomic_load(&job.overflow)) {
+            *out = PolyFromDenseCoeffs(&job, 0, 0);
+            result = true;
+        }
+        free(job.values);
+    }
+
+    free(sub_terms);
+    free(sub_degs);
+    free(acc);
+    free(job.bound);
+    free(job.stride);
+    return result;
+}
+
+
+/**
+ * Dane rozwinięcia wielomianowego \f$ (t_1 + \ldots + t_m)^e = \sum \binom{e}{k_1, \ldots, k_m} \prod t_i^{k_i} \f$.
+ */
+typedef struct
+{
+    ///Wyrazy podstawy
+    const PolyTermList *base;
+
+    ///Trójkąt Pascala: \f$ \binom{r}{k} \f$ ma indeks \f$ r(r+1)/2 + k \f$; <c>NULL</c>, gdy podstawa ma jeden wyraz
+    const poly_coeff_t *binomials;
+
+    ///Wektor wykładników zgromadzony dla wcześniejszych wyrazów podstawy
+    poly_exp_t *exps;
+
+    ///Lista, do której dopisywane są wyrazy wyniku
+    PolyTermList *result;
+} PolyMultinomialJob;
+
+
+/**
+ * Generuje wyrazy rozwinięcia wielomianowego, wybierając wykładnik <c>index</c>-tego wyrazu podstawy.
+ * Wielomianowy współczynnik jest iloczynem \f$ \binom{r}{k} \f$ dla kolejnych wyrazów, gdzie \f$ r \f$ to
+ * pozostała część wykładnika.
+ * @param job dane rozwinięcia
+ * @param index indeks wyrazu podstawy
+ * @param remaining pozostała część wykładnika
+ * @param coef współczynnik zgromadzony dla wcześniejszych wyrazów podstawy
+ */
+static void PolyPowMultinomialTerms(PolyMultinomialJob *job, size_t index, poly_exp_t remaining, poly_coeff_t coef)
+{
+    const PolyTermList *base = job->base;
+    const poly_exp_t *vector = base->exps + index * base->dims;
+    bool last = index + 1 == base->count;
+
+    for (poly_exp_t k = last ? remaining : 0; k <= remaining; ++k) {
+        poly_coeff_t factor = CoeffMul(coef, QuickPower(base->coefs[index], k));
+        if (!last)
+            factor = CoeffMul(factor, job->binomials[(size_t)remaining * (remaining + 1) / 2 + k]);
+        if (factor == 0)
+            continue;
+
+        for (unsigned d = 0; d < base->dims; ++d)
+            job->exps[d] += k * vector[d];
+        if (last) {
+            PolyTermList *result = job->result;
+            result->coefs[result->count] = factor;
+            memcpy(result->exps + result->count * result->dims, job->exps, sizeof(poly_exp_t) * result->dims);
+            ++result->count;
+        } else {
+            PolyPowMultinomialTerms(job, index + 1, remaining - k, factor);
+        }
+        for (unsigned d = 0; d < base->dims; ++d)
+            job->exps[d] -= k * vector[d];
+    }
+}
+
+
+/**
+ * Potęguje wielomian o co najwyżej <c>POLY_POW_MULTINOMIAL_MAX_TERMS</c> wyrazach przez rozwinięcie wielomianowe.
+ * Każdy wyraz wyniku powstaje bezpośrednio, bez pośrednich iloczynów. Współczynniki dwumianowe są liczone w
+ * trójkącie Pascala (samymi dodawaniami), więc przepełnienia zachowują się tak samo jak przy zwykłym mnożeniu.
+ * @param p potęgowany wielomian; nie może być współczynnikiem
+ * @param exp wykładnik (dodatni)
+ * @param out miejsce na wynik
+ * @return <c>true</c>, gdy wynik został obliczony; <c>false</c>, gdy podstawa ma zbyt wiele wyrazów, wynik byłby
+ * zbyt duży lub współczynniki mogą wyjść poza <c>poly_coeff_t</c> (CoeffMaySpill())
+ */
+static bool PolyPowMultinomial(const Poly *p, poly_exp_t exp, Poly *out)
+{
+    if (CoeffMaySpill())
+        return false;
+
+    size_t capacity = PolyCountTerms(p, INT32_MAX);
+    if (capacity > POLY_POW_MULTINOMIAL_MAX_TERMS)
+        return false;
+
+    unsigned dims = PolyVarCount(p);
+    MonoSubstitution *identity = malloc(sizeof(MonoSubstitution) * dims);
+    poly_exp_t *exps = calloc(dims, sizeof(poly_exp_t));
+    PolyTermList base = {.dims = dims, .count = 0};
+    base.coefs = malloc(sizeof(poly_coeff_t) * capacity);
+    base.exps = malloc(sizeof(poly_exp_t) * capacity * dims);
+    assert(identity != NULL && exps != NULL && base.coefs != NULL && base.exps != NULL);
+    for (unsigned i = 0; i < dims; ++i)
+        identity[i] = (MonoSubstitution){.coef = 1, .var = i, .exp = 1};
+    PolyFlattenTerms(p, (poly_exp_t)dims, identity, 1, exps, &base);
+
+    double count = 1;
+    poly_exp_t max_exp = 0;
+    for (size_t i = 1; i < base.count; ++i)
+        count = count * (double)(exp + (poly_exp_t)i) / (double)i;
+    for (size_t i = 0; i < base.count * dims; ++i)
+        max_exp = max_exp > base.exps[i] ? max_exp : base.exps[i];
+
+    bool result = (base.count <= 1 || exp <= POLY_POW_MULTINOMIAL_MAX_EXP)
+                  && count <= POLY_POW_MULTINOMIAL_MAX_RESULT && (int64_t)max_exp * exp <= INT32_MAX;
+    if (result) {
+        poly_coeff_t *binomials = NULL;
+        if (base.count > 1) {
+            binomials = malloc(sizeof(poly_coeff_t) * ((size_t)(exp + 1) * (exp + 2) / 2));
+            assert(binomials != NULL);
+            for (size_t r = 0; r <= (size_t)exp; ++r) {
+                poly_coeff_t *row = binomials + r * (r + 1) / 2;
+                row[0] = row[r] = 1;
+                for (size_t k = 1; k < r; ++k)
+                    row[k] = CoeffAdd(row[k - r - 1], row[k - r]);
+            }
+        }
+
+        PolyTermList terms = {.dims = dims, .count = 0};
+        terms.coefs = malloc(sizeof(poly_coeff_t) * (size_t)count);
+        terms.exps = malloc(sizeof(poly_exp_t) * (size_t)count * dims);
+        assert(terms.coefs != NULL && terms.exps != NULL);
+        PolyMultinomialJob job = {.base = &base, .binomials = binomials, .exps = exps, .result = &terms};
+        if (base.count > 0)
+            PolyPowMultinomialTerms(&job, 0, exp, 1);
+
+        size_t *order = malloc(sizeof(size_t) * terms.count);
+        assert(order != NULL || terms.count == 0);
+        for (size_t i = 0; i < terms.count; ++i)
+            order[i] = i;
+        PolySortTerms(&terms, order);
+        *out = PolyFromSortedTerms(&terms, order, 0, terms.count, 0);
+
+        free(order);
+        free(terms.coefs);
+        free(terms.exps);
+        free(binomials);
+    }
+
+    free(identity);
+    free(exps);
+    free(base.coefs);
+    free(base.exps);
+    return result;
+}
+
+
+/**
+ * Potęguje gęsty wielomian jednej zmiennej o stałych współczynnikach rekurencją J.C.P. Millera.
+ * Dla \f$ g = \sum_{i=0}^n g_i x^i \f$, \f$ g_0 \neq 0 \f$ współczynniki \f$ h = g^e \f$ spełniają
+ * \f$ k g_0 h_k = \sum_{i=1}^{\min(k, n)} ((e + 1) i - k) g_i h_{k-i} \f$, co daje wynik w czasie
+ * \f$ O(n^2 e) \f$ zamiast \f$ O(n^2 e^2) \f$. Rekurencja wymaga dzielenia, więc jest liczona dokładnie; przy
+ * przekroczeniu zakresu <c>poly_coeff_t</c> oraz w arytmetyce modularnej i dokładnej funkcja się wycofuje.
+ * @param p potęgowany wielomian; nie może być współczynnikiem
+ * @param exp wykładnik (dodatni)
+ * @param out miejsce na wynik
+ * @return <c>true</c>, gdy wynik został obliczony; <c>false</c>, gdy wielomian nie ma oczekiwanej postaci lub
+ * obliczenia wyszły poza zakres
+ */
+static bool PolyPowMiller(const Poly *p, poly_exp_t exp, Poly *out)
+{
+    if (PolyModular.modulus != 0 || PolyExactCoefficients)
+        return false;
+
+    poly_exp_t low = -1, high = 0, terms = 0;
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (!PolyIsCoeff(&p->monos[i].p))
+            return false;
+        if (PolyIsZero(&p->monos[i].p))
+            continue;
+        low = low < 0 ? p->monos[i].exp : low;
+        high = p->monos[i].exp;
+        ++terms;
+    }
+    int64_t n = (int64_t)high - low;
+    if (terms == 0 || 2 * (int64_t)terms < n + 1 || (int64_t)high * exp > INT32_MAX)
+        return false;
+
+    int64_t length = n * exp + 1;
+    poly_coeff_t *g = calloc((size_t)n + 1, sizeof(poly_coeff_t));
+    poly_coeff_t *h = malloc(sizeof(poly_coeff_t) * (size_t)length);
+    assert(g != NULL && h != NULL);
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (!PolyIsZero(&p->monos[i].p))
+            g[p->monos[i].exp - low] = p->monos[i].p.asCoef;
+    }
+
+    bool overflow = false;
+    h[0] = QuickPowerChecked(g[0], exp, &overflow);
+    poly_exp_t nonzero = h[0] != 0;
+    for (int64_t k = 1; k < length && !overflow; ++k) {
+        poly_coeff_t sum = 0, divisor;
+        for (int64_t i = 1; i <= n && i <= k; ++i) {
+            if (g[i] == 0)
+                continue;
+            poly_coeff_t term;
+            overflow |= __builtin_mul_overflow((exp + 1) * i - k, g[i], &term);
+            overflow |= __builtin_mul_overflow(term, h[k - i], &term);
+            overflow |= __builtin_add_overflow(sum, term, &sum);
+        }
+        overflow |= __builtin_mul_overflow(k, g[0], &divisor);
+        //POLY_COEFF_MIN % -1 też przekracza zakres, więc ten przypadek trzeba sprawdzić przed resztą z dzielenia
+        if (!overflow && ((divisor == -1 && sum == POLY_COEFF_MIN) || sum % divisor != 0))
+            overflow = true;
+        if (!overflow) {
+            h[k] = sum / divisor;
+            nonzero += h[k] != 0;
+        }
+    }
+
+    if (!overflow) {
+        Poly result;
+        result.length = 0;
+        result.monos = MonosAlloc(nonzero);
+        assert(result.monos != NULL);
+        for (int64_t k = 0; k < length; ++k) {
+            if (h[k] != 0)
+                result.monos[result.length++] = (Mono){.p = PolyFromCoeff(h[k]), .exp = low * exp + k};
+        }
+        *out = PolySimplifyCoeff(result);
+    }
+
+    free(g);
+    free(h);
+    return !overflow;
+}
+
+
+/**
+ * Sprawdza, czy wielomian jest rzadki: czy ma wyraźnie mniej wyrazów niż prostopadłościan jego stopni.
+ * @param p badany wielomian
+ * @return <c>true</c>, gdy wielomian jest rzadki; <c>false</c> w.p.p.
+ */
+static bool PolyPowIsSparse(const Poly *p)
+{
+    double box = 1;
+    unsigned dims = PolyVarCount(p);
+    for (unsigned j = 0; j < dims; ++j)
+        box *= (double)PolyDegBy(p, j) + 1;
+    return (double)PolyCountTerms(p, INT32_MAX) * POLY_POW_SPARSE_FACTOR < box;
+}
+
+
+/**
+ * Potęgowanie przez wielokrotne mnożenie przez podstawę.
+ * Dla rzadkich podstaw jest szybsze od podnoszenia do kwadratu: każde mnożenie ma koszt proporcjonalny do
+ * rozmiaru wyniku częściowego razy liczba wyrazów podstawy, a nie do kwadratu rozmiaru wyniku częściowego.
+ * @param p potęgowany wielomian
+ * @param exp wykładnik (dodatni)
+ * @return wielomian \f$ p^\text{exp} \f$
+ */
+static Poly PolyPowRepeated(const Poly *p, poly_exp_t exp)
+{
+    Poly result = PolyClone(p);
+    for (poly_exp_t i = 1; i < exp; ++i) {
+        Poly next = PolyMul(&result, p);
+        PolyDestroy(&result);
+        result = next;
+    }
+    return result;
+}
+
+
+/**
+ * Szybkie potęgowanie wielomianów.
+ * Dla podanego wielomianu \f$ p \f$ zwraca \f$ p^\text{exp} \f$, dobierając algorytm do kształtu podstawy.
+ * @param p potęgowany wielomian
+ * @param exp wykładnik (człkowity, nieujemny)
+ * @return wielomian \f$ p^\text{exp} \f$
+ */
+static Poly PolyQuickPower(const Poly *p, poly_exp_t exp)
+{
+    assert(exp >= 0);
+    if (exp == 0)
+        return PolyFromCoeff(1);
+    if (PolyIsCoeff(p))
+        return CoeffMaySpill() ? CoeffPower(p, exp) : PolyFromCoeff(QuickPower(p->asCoef, exp));
+    if (exp == 1)
+        return PolyClone(p);
+
+    Poly result;
+    Poly zero = PolyZero();
+    PolyCacheKey key = PolyCacheKeyOf(POLY_CACHE_POW, p, &zero, exp);
+    if (PolyCacheFind(&key, &result))
+        return result;
+    if (!PolyPowMultinomial(p, exp, &result) && !PolyPowMiller(p, exp, &result))
+        result = PolyPowIsSparse(p) ? PolyPowRepeated(p, exp) : PolyPowSquaring(p, exp);
+    return PolyCacheStore(&key, result);
+}
+
+
+Poly PolyPow(const Poly *p, poly_exp_t exp)
+{
+    return PolyQuickPower(p, exp);
+}
+
+
+/**
+ * Symboliczna implementacja PolyCompose(): podnosi podstawienia do potęg i mnoży je przez złożone współczynniki.
+ * @param p wielomian, w którym podstawiamy zmienne
+ * @param vars_subs_count liczba elementów tablicy <c>vars_subs</c>
+ * @param vars_subs tablica z podstawieniami dla kolejnych zmiennych
+ * @return złożenie wielomianów
+ */
+static Poly PolyComposeSymbolic(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs)
+{
+    if (PolyIsCoeff(p))
+        return PolyClone(p);
+    if (vars_subs_count == 0)
+        return ExactCoefficient(p);
+
+    Poly result = PolyZero();
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        Poly composed_coef = PolyComposeSymbolic(&p->monos[i].p, vars_subs_count - 1, vars_subs + 1);
+
+        if (!PolyIsZero(&composed_coef)) {
+            Poly cpow = PolyQuickPower(vars_subs + 0, p->monos[i].exp);
+            Poly composed_mono = PolyMul(&cpow, &composed_coef);
+            Poly new_result = PolyAdd(&result, &composed_mono);
+            PolyDestroy(&cpow);
+            PolyDestroy(&composed_mono);
+            PolyDestroy(&result);
+            result = new_result;
+        }
+
+        PolyDestroy(&composed_coef);
+    }
+
+    return result;
+}
+
+
+/**
+ * Składnik sumy k-krotnej: jego jednomiany najwyższego poziomu i pozycja następnego, który nie trafił jeszcze do
+ * scalenia. Niezerowy współczynnik jest traktowany jak jeden jednomian o wykładniku 0.
+ */
+typedef struct
+{
+    ///Jednomiany składnika
+    const Mono *monos;
+
+    ///Liczba jednomianów
+    poly_exp_t length;
+
+    ///Indeks następnego jednomianu
+    poly_exp_t next;
+
+    ///Miejsce na jednomian zastępujący współczynnik
+    Mono single;
+} PolySumSource;
+
+
+/**
+ * Dane sumowania współczynników przy kolejnych wykładnikach w PolySumMany().
+ */
+typedef struct
+{
+    ///Scalone jednomiany składników, niemalejąco według wykładników
+    Mono *merged;
+
+    ///Początki grup jednomianów o równych wykładnikach oraz długość <c>merged</c> na pozycji liczby grup
+    size_t *starts;
+
+    ///Sumy współczynników grup
+    Poly *sums;
+} PolySumJob;
+
+
+static Poly PolySumMany(Poly *polys, size_t count, bool parallel);
+
+
+/**
+ * Przesiewa w dół kopiec składników uporządkowany według wykładnika następnego jednomianu (a przy równych wykładnikach
+ * według indeksu składnika).
+ * @param heap kopiec indeksów składników
+ * @param size rozmiar kopca
+ * @param i pozycja przesiewanego elementu
+ * @param sources składniki
+ */
+static void PolySumHeapSiftDown(size_t *heap, size_t size, size_t i, const PolySumSource *sources)
+{
+    for (;;) {
+        size_t smallest = i;
+        for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < size; ++child) {
+            const PolySumSource *a = sources + heap[child], *b = sources + heap[smallest];
+            poly_exp_t a_exp = a->monos[a->next].exp, b_exp = b->monos[b->next].exp;
+            if (a_exp < b_exp || (a_exp == b_exp && heap[child] < heap[smallest]))
+                smallest = child;
+        }
+        if (smallest == i)
+            return;
+        size_t swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+
+/**
+ * Sumuje współczynniki jednej grupy jednomianów o równych wykładnikach.
+ * @param context wskaźnik na <c>PolySumJob</c>
+ * @param group indeks grupy
+ */
+static void PolySumGroupTask(void *context, size_t group)
+{
+    PolySumJob *job = context;
+    size_t begin = job->starts[group], end = job->starts[group + 1];
+    if (end - begin == 1) {
+        job->sums[group] = job->merged[begin].p;
+        return;
+    }
+    Poly *coefs = malloc(sizeof(Poly) * (end - begin));
+    assert(coefs != NULL);
+    for (size_t i = begin; i < end; ++i)
+        coefs[i - begin] = job->merged[i].p;
+    job->sums[group] = PolySumMany(coefs, end - begin, false);
+    free(coefs);
+}
+
+
+/**
+ * Sumuje wielomiany jednym scaleniem k-krotnym zamiast dodawać je parami: jednomiany najwyższego poziomu wszystkich
+ * składników są scalane kopcem według wykładników, a współczynniki przy równych wykładnikach są sumowane
+ * rekurencyjnie w ten sam sposób.
+ * @param polys składniki (przejmowane na własność)
+ * @param count liczba składników (dodatnia)
+ * @param parallel czy współczynniki przy różnych wykładnikach sumować na wątkach roboczych
+ * @return suma składników
+ */
+static Poly PolySumMany(Poly *polys, size_t count, bool parallel)
+{
+    if (count == 1)
+        return polys[0];
+
+    bool all_coeffs = true;
+    for (size_t i = 0; i < count && all_coeffs; ++i)
+        all_coeffs = PolyIsCoeff(polys + i);
+    if (all_coeffs) {
+        Poly sum = polys[0];
+        for (size_t i = 1; i < count; ++i) {
+            Poly next = PolyAdd(&sum, polys + i);
+            PolyDestroy(&sum);
+            PolyDestroy(polys + i);
+            sum = next;
+        }
+        return sum;
+    }
+
+    PolySumSource *sources = malloc(sizeof(PolySumSource) * count);
+    size_t *heap = malloc(sizeof(size_t) * count);
+    assert(sources != NULL && heap != NULL);
+    size_t total = 0, heap_size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        PolySumSource *source = sources + i;
+        if (PolyIsCoeff(polys + i)) {
+            source->single = (Mono){.p = polys[i], .exp = 0};
+            source->monos = &source->single;
+            source->length = !PolyIsZero(polys + i);
+        } else {
+            source->monos = polys[i].monos;
+            source->length = polys[i].length;
+        }
+        source->next = 0;
+        total += (size_t)source->length;
+        if (source->length > 0)
+            heap[heap_size++] = i;
+    }
+    for (size_t i = heap_size / 2; i-- > 0;)
+        PolySumHeapSiftDown(heap, heap_size, i, sources);
+
+    PolySumJob job;
+    job.merged = malloc(sizeof(Mono) * total);
+    job.starts = malloc(sizeof(size_t) * (total + 1));
+    assert(job.merged != NULL && job.starts != NULL);
+    size_t groups = 0;
+    for (size_t k = 0; k < total; ++k) {
+        PolySumSource *source = sources + heap[0];
+        job.merged[k] = MonoClone(source->monos + source->next);
+        if (k == 0 || job.merged[k].exp != job.merged[k - 1].exp)
+            job.starts[groups++] = k;
+        if (++source->next == source->length)
+            heap[0] = heap[--heap_size];
+        PolySumHeapSiftDown(heap, heap_size, 0, sources);
+    }
+    job.starts[groups] = total;
+    for (size_t i = 0; i < count; ++i)
+        PolyDestroy(polys + i);
+    free(sources);
+    free(heap);
+
+    job.sums = malloc(sizeof(Poly) * groups);
+    assert(job.sums != NULL);
+    if (parallel) {
+        PolyParallelFor(groups, PolySumGroupTask, &job);
+    } else {
+        for (size_t g = 0; g < groups; ++g)
+            PolySumGroupTask(&job, g);
+    }
+
+    Poly result = {.monos = MonosAlloc(groups), .length = 0};
+    assert(result.monos != NULL);
+    for (size_t g = 0; g < groups; ++g) {
+        if (PolyIsZero(job.sums + g))
+            PolyDestroy(job.sums + g);
+        else
+            result.monos[result.length++] = (Mono){.p = job.sums[g], .exp = job.merged[job.starts[g]].exp};
     }
-
-    return PolySimplifyCoeff(fold);
+    free(job.merged);
+    free(job.starts);
+    free(job.sums);
+    if (result.length == 0) {
+        MonosFree(result.monos);
+        return PolyZero();
+    }
+    return PolySimplifyCoeff(result);
 }
 
 
-Poly PolyAddMonos(unsigned count, const Mono *monos)
+/**
+ * Dane wspólne równoległego składania wielomianów.
+ */
+typedef struct
 {
-    Mono *m_copy = malloc(sizeof(Mono) * count);
-    assert(m_copy != NULL);
-    for (poly_exp_t i = 0; i < (poly_exp_t )count; ++i)
-        m_copy[i] = monos[i];
-    return PolyFromMonos(m_copy, count);
-}
+    ///Składany wielomian
+    const Poly *p;
 
+    ///Liczba podstawień
+    poly_exp_t count;
 
-Poly PolyAddCopiedMonos(unsigned count, const Mono *monos)
-{
-    Mono *m_copy = malloc(sizeof(Mono) * count);
-    assert(m_copy != NULL);
-    for (poly_exp_t i = 0; i < (poly_exp_t )count; ++i)
-        m_copy[i] = MonoClone(monos + i);
-    return PolyFromMonos(m_copy, count);
-}
+    ///Podstawienia
+    const Poly *subs;
 
+    ///Wyniki częściowe: złożone jednomiany
+    Poly *partial;
 
-Poly PolyClone(const Poly *p)
-{
-    Poly result;
-    if (PolyIsCoeff(p)) {
-        result.monos = NULL;
-        result.asCoef = p->asCoef;
-    } else {
-        result.length = p->length;
-        result.monos = malloc(sizeof(Mono) * result.length);
-        assert(result.monos != NULL);
-        for (poly_exp_t i = 0; i < result.length; ++i)
-            result.monos[i] = MonoClone(&p->monos[i]);
-    }
-    return result;
-}
+    ///Liczba wyników częściowych
+    size_t length;
+} PolyComposeJob;
 
 
-Poly PolyNeg(const Poly *p)
+/**
+ * Składa jeden jednomian najwyższego poziomu: \f$ \text{subs[0]}^e \cdot \text{coef}(\text{subs[1]}, \ldots) \f$.
+ * @param context wskaźnik na <c>PolyComposeJob</c>
+ * @param index indeks jednomianu
+ */
+static void PolyComposeMonoTask(void *context, size_t index)
 {
-    Poly result;
-    if (PolyIsCoeff(p)) {
-        result.monos = NULL;
-        result.asCoef = -p->asCoef;
-    } else {
-        result.monos = malloc(sizeof(Mono) * p->length);
-        assert(result.monos != NULL);
-        result.length = p->length;
-        for (poly_exp_t i = 0; i < result.length; ++i) {
-            result.monos[i].exp = p->monos[i].exp;
-            result.monos[i].p = PolyNeg(&p->monos[i].p);
-        }
+    PolyComposeJob *job = context;
+    const Mono *m = job->p->monos + index;
+    Poly composed_coef = PolyComposeSymbolic(&m->p, job->count - 1, job->subs + 1);
+
+    if (PolyIsZero(&composed_coef)) {
+        job->partial[index] = composed_coef;
+        return;
     }
-    return result;
+    Poly cpow = PolyQuickPower(job->subs + 0, m->exp);
+    job->partial[index] = PolyMul(&cpow, &composed_coef);
+    PolyDestroy(&cpow);
+    PolyDestroy(&composed_coef);
 }
 
 
-Poly PolySub(const Poly *p, const Poly *q)
+/**
+ * Wielowątkowa wersja PolyComposeSymbolic() dla wielomianów o wielu jednomianach najwyższego poziomu.
+ * Jednomiany są składane niezależnie na wątkach roboczych, a wyniki częściowe sumowane jednym scaleniem k-krotnym
+ * (PolySumMany()), w którym współczynniki przy różnych wykładnikach również są sumowane równolegle.
+ * @param p wielomian, w którym podstawiamy zmienne; nie może być współczynnikiem
+ * @param vars_subs_count liczba podstawień (dodatnia)
+ * @param vars_subs podstawienia
+ * @return złożenie wielomianów
+ */
+static Poly PolyComposeParallel(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs)
 {
-    Poly q_neg = PolyNeg(q);
-    Poly result = PolyAdd(p, &q_neg);
-    PolyDestroy(&q_neg);
-    return PolySimplifyCoeff(result);
+    PolyComposeJob job = {
+            .p = p,
+            .count = vars_subs_count,
+            .subs = vars_subs,
+            .length = (size_t)p->length,
+    };
+    job.partial = malloc(sizeof(Poly) * job.length);
+    assert(job.partial != NULL);
+
+    PolyParallelFor(job.length, PolyComposeMonoTask, &job);
+    Poly result = PolySumMany(job.partial, job.length, true);
+    free(job.partial);
+    return result;
 }
 
 
-poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx)
+Poly PolyCompose(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs)
 {
-    if (PolyIsZero(p))
-        return -1;
     if (PolyIsCoeff(p))
-        return 0;
-
-    if (var_idx == 0) {
-        for (poly_exp_t i = p->length - 1; i >= 0; --i) {
-            if (!PolyIsZero(&p->monos[i].p))
-                return p->monos[i].exp;
-        }
-        assert(false);
-    }
+        return PolyClone(p);
+    if (vars_subs_count == 0)
+        return ExactCoefficient(p);
 
-    poly_exp_t max = 0;
-    for (poly_exp_t i = 0; i < p->length; ++i) {
-        poly_exp_t ith_deg = PolyDegBy(&p->monos[i].p, var_idx - 1);
-        max = max > ith_deg ? max : ith_deg;
-    }
-    return max;
+    Poly result;
+    if (PolyComposeMonomials(p, vars_subs_count, vars_subs, &result))
+        return result;
+    if (PolyComposeShift(p, vars_subs_count, vars_subs, &result))
+        return result;
+    if (PolyComposeInterpolation(p, vars_subs_count, vars_subs, &result))
+        return result;
+    if (p->length >= POLY_PARALLEL_COMPOSE_THRESHOLD && PolyGetThreadCount() > 1)
+        return PolyComposeParallel(p, vars_subs_count, vars_subs);
+    return PolyComposeSymbolic(p, vars_subs_count, vars_subs);
 }
 
 
-poly_exp_t PolyDeg(const Poly *p)
+/**
+ * Działanie wykonywane przez PolyMulChecked() lub PolyComposeChecked() wraz z danymi do sprawdzenia jego wyniku.
+ */
+typedef struct
 {
-    if (PolyIsZero(p))
-        return -1;
-    if (PolyIsCoeff(p))
-        return 0;
+    ///Pierwszy argument działania
+    const Poly *p;
 
-    poly_exp_t max = 0;
-    for (poly_exp_t i = 0; i < p->length; ++i) {
-        if (PolyIsZero(&p->monos[i].p))
-            continue;
-        poly_exp_t ith_deg = PolyDeg(&p->monos[i].p) + p->monos[i].exp;
-        max = max > ith_deg ? max : ith_deg;
-    }
+    ///Liczba pozostałych argumentów
+    poly_exp_t count;
 
-    return max;
-}
+    ///Pozostałe argumenty: czynnik PolyMul() albo podstawienia PolyCompose()
+    const Poly *args;
+
+    ///Czy działaniem jest PolyCompose()
+    bool compose;
+
+    ///Wynik obliczony w arytmetyce <c>poly_coeff_t</c>, czyli modulo \f$ 2^{w} \f$ (<c>w = POLY_COEFF_BITS</c>)
+    const Poly *wrapped;
+
+    ///Ustawiane, gdy wynik modulo któregoś z modułów różni się od <c>wrapped</c>
+    atomic_bool overflow;
+} PolyCheckedJob;
 
 
 /**
- * Porównuje wielomian is współczynnik.
- * Sprawdza czy wielomian <c>p</c>, który nie jest współczynnikiem, jest równy wielomianowi <c>q</c>,
- * który jest współczynnikiem.
- * @param p wielomian-nie-współczynnik
- * @param q wielomian-współczynnik
- * @return <c>true</c> gdy <c>p == q</c>, a <c>false</c> w przeciwnym wypadku
+ * Wykonuje działanie w bieżącej arytmetyce współczynników.
+ * @param job działanie
+ * @param p pierwszy argument
+ * @param args pozostałe argumenty
+ * @return wynik działania
  */
-static bool PolyIsEqPC(const Poly *p, const Poly *q)
+static Poly PolyCheckedApply(const PolyCheckedJob *job, const Poly *p, const Poly *args)
 {
-    assert(p->monos != NULL);
-    assert(q->monos == NULL);
-    if (p->monos[0].exp != 0)
-        return false;
-    if (!PolyIsEq(&p->monos[0].p, q))
-        return false;
-    for (poly_exp_t i = 1; i < p->length; ++i) {
-        if (!PolyIsZero(&p->monos[i].p))
-            return false;
-    }
-    return true;
+    return job->compose ? PolyCompose(p, job->count, args) : PolyMul(p, args);
 }
 
 
-bool PolyIsEq(const Poly *p, const Poly *q)
+/**
+ * Sumuje z nasyceniem oszacowania liczby bitów.
+ * @param a liczba bitów
+ * @param b liczba bitów
+ * @return \f$ \min(a + b, \text{POLY_CHECKED_BITS_LIMIT}) \f$
+ */
+static inline uint64_t CheckedBitsAdd(uint64_t a, uint64_t b)
 {
-    if (!PolyIsCoeff(p) && PolyIsCoeff(q))
-        return PolyIsEqPC(p, q);
-    if (PolyIsCoeff(p) && !PolyIsCoeff(q))
-        return PolyIsEqPC(q, p);
-    if (p->monos == NULL)
-        return p->asCoef == q->asCoef;
-
-    poly_exp_t i = 0, j = 0;
-    while (i < p->length && j < q->length) {
-        if (p->monos[i].exp < q->monos[j].exp) {
-            if (!PolyIsZero(&p->monos[i].p))
-                return false;
-            ++i;
-        } else if (p->monos[i].exp > q->monos[j].exp) {
-            if (!PolyIsZero(&q->monos[j].p))
-                return false;
-            ++j;
-        } else {
-            if (!PolyIsEq(&p->monos[i].p, &q->monos[j].p))
-                return false;
-            ++i, ++j;
-        }
-    }
+    uint64_t sum;
+    if (__builtin_add_overflow(a, b, &sum) || sum > POLY_CHECKED_BITS_LIMIT)
+        return POLY_CHECKED_BITS_LIMIT;
+    return sum;
+}
 
-    for (; i < p->length; ++i) {
-        if (!PolyIsZero(&p->monos[i].p))
-            return false;
-    }
-    for (; j < q->length; ++j) {
-        if (!PolyIsZero(&p->monos[j].p))
-            return false;
-    }
 
-    return true;
+/**
+ * Zwraca liczbę bitów liczby.
+ * @param x liczba
+ * @return najmniejsze \f$ b \f$ takie, że \f$ x < 2^b \f$
+ */
+static inline uint64_t BitLength(uint64_t x)
+{
+    return x == 0 ? 0 : 64 - (uint64_t)__builtin_clzll(x);
 }
 
 
-Poly PolyAt(const Poly *p, poly_coeff_t x)
+/**
+ * Szacuje sumę modułów współczynników wielomianu po podstawieniu.
+ * Dla każdej zmiennej <c>var</c> o indeksie mniejszym od <c>count</c> przyjmuje, że suma modułów współczynników
+ * podstawienia jest mniejsza od \f$ 2^{\text{sub_bits[var]}} \f$; pozostałe zmienne są zamieniane na 0, tak jak w
+ * PolyCompose(). Gdy <c>sub_bits == NULL</c>, szacowana jest suma modułów współczynników samego wielomianu.
+ * @param p wielomian (bez dużych współczynników)
+ * @param depth indeks zmiennej głównej wielomianu
+ * @param count liczba podstawień
+ * @param sub_bits oszacowania podstawień albo <c>NULL</c>
+ * @return \f$ b \f$ takie, że suma modułów współczynników wyniku jest mniejsza od \f$ 2^b \f$
+ */
+static uint64_t PolyNormBits(const Poly *p, poly_exp_t depth, poly_exp_t count, const uint64_t *sub_bits)
 {
+    assert(!PolyIsBigCoeff(p));
     if (PolyIsCoeff(p))
-        return *p;
-    Poly result = PolyZero();
+        return BitLength(p->asCoef < 0 ? -(uint64_t)p->asCoef : (uint64_t)p->asCoef);
 
+    uint64_t bits = 0;
     for (poly_exp_t i = 0; i < p->length; ++i) {
-        Poly old_result = result;
-        poly_coeff_t power = QuickPower(x, p->monos[i].exp);
-        Poly evaluated_mono = PolyClone(&p->monos[i].p);
-        PolyScaleInplace(&evaluated_mono, power);
-        result = PolyAdd(&old_result, &evaluated_mono);
-
-        PolyDestroy(&old_result);
-        PolyDestroy(&evaluated_mono);
+        if (sub_bits != NULL && depth >= count && p->monos[i].exp > 0)
+            continue;
+        uint64_t term = PolyNormBits(&p->monos[i].p, depth + 1, count, sub_bits);
+        if (sub_bits != NULL && depth < count) {
+            uint64_t power;
+            if (__builtin_mul_overflow(sub_bits[depth], (uint64_t)p->monos[i].exp, &power))
+                power = POLY_CHECKED_BITS_LIMIT;
+            term = CheckedBitsAdd(term, power);
+        }
+        if (term > bits)
+            bits = term;
     }
-
-    return result;
+    return CheckedBitsAdd(bits, BitLength((uint64_t)p->length));
 }
 
 
-void PolyPrint(const Poly *p, FILE *stream)
+/**
+ * Szacuje liczbę bitów współczynników wyniku działania.
+ * @param job działanie
+ * @return \f$ b \f$ takie, że moduł każdego współczynnika wyniku jest mniejszy od \f$ 2^b \f$
+ */
+static uint64_t PolyCheckedBits(const PolyCheckedJob *job)
 {
-    if (p->monos == NULL) {
-        fprintf(stream, "%lli", (long long int) p->asCoef);
-    } else {
-        bool prepend_plus = false;
-        for (poly_exp_t i = 0; i < p->length; ++i) {
-            if (PolyIsZero(&p->monos[i].p))
-                continue;
-            if (prepend_plus)
-                fputc('+', stream);
-            fputc('(', stream);
-            PolyPrint(&p->monos[i].p, stream);
-            fputc(',', stream);
-            fprintf(stream, "%lu", (long unsigned)p->monos[i].exp);
-            fputc(')', stream);
-            prepend_plus = true;
-        }
-    }
+    if (!job->compose)
+        return CheckedBitsAdd(PolyNormBits(job->p, 0, 0, NULL), PolyNormBits(job->args, 0, 0, NULL));
+
+    uint64_t *sub_bits = malloc(sizeof(uint64_t) * job->count);
+    assert(sub_bits != NULL);
+    for (poly_exp_t i = 0; i < job->count; ++i)
+        sub_bits[i] = PolyNormBits(job->args + i, 0, 0, NULL);
+    uint64_t bits = PolyNormBits(job->p, 0, job->count, sub_bits);
+    free(sub_bits);
+    return bits;
 }
 
 
 /**
- * Szybkie potęgowanie wielomianów.
- * Dla podanego wielomianu \f$ p \f$ zwraca \f$ p^\text{exp} \f$. Implementacja nie jest ogonowa, gdyż nie
- * i tak potrzebujemy dużo pamięci na wynik.
- * @param p potęgowany wielomian
- * @param exp wykładnik (człkowity, nieujemny)
- * @return wielomian \f$ p^\text{exp} \f$
+ * Sprawdza, czy wielomian ma duży współczynnik.
+ * @param p wielomian
+ * @return czy któryś ze współczynników <c>p</c> nie mieści się w <c>poly_coeff_t</c>
  */
-static Poly PolyQuickPower(const Poly *p, poly_exp_t exp)
+static bool PolyHasBigCoeff(const Poly *p)
 {
-    assert(exp >= 0);
-    if (PolyIsZero(p))
-        return PolyZero();
-    if (exp == 0)
-        return PolyFromCoeff(1);
-    if (exp == 1)
-        return PolyClone(p);
-
-    Poly root = PolyQuickPower(p, exp / 2);
-    Poly result;
-    if (exp % 2 == 0) {
-        result = PolyMul(&root, &root);
-    } else {
-        Poly half_result = PolyMul(&root, &root);
-        result = PolyMul(&half_result, p);
-        PolyDestroy(&half_result);
+    if (PolyIsCoeff(p))
+        return PolyIsBigCoeff(p);
+    for (poly_exp_t i = 0; i < p->length; ++i) {
+        if (PolyHasBigCoeff(&p->monos[i].p))
+            return true;
     }
-    PolyDestroy(&root);
-    return result;
+    return false;
 }
 
 
 /**
- * Zwraca wyraz wolny wielomianu.
- * Zwrócony wielomian jest współczynnikiem. Moze zostać zniszczony (wywołujący dostaje go na własność: wielomian
- * jest alokowany przez tę funkcję).
- * @param p odpytywany wielmian
- * @return wyraz wolny wielomianu \f$ p \f$
+ * Oblicza wynik działania modulo <c>PolyCheckedPrimes[index]</c> i porównuje go z wynikiem w arytmetyce
+ * <c>poly_coeff_t</c>.
+ * @param context wskaźnik na <c>PolyCheckedJob</c>
+ * @param index indeks modułu
  */
-static Poly ExactCoefficient(const Poly *p)
+static void PolyCheckedResidueTask(void *context, size_t index)
 {
-    if (PolyIsCoeff(p))
-        return PolyClone(p);
-    if (p->monos[0].exp == 0)
-        return ExactCoefficient(&p->monos[0].p);
-    return PolyZero();
+    PolyCheckedJob *job = context;
+    PolyModularArithmetic saved = PolyModular;
+    PolySetModulus((poly_coeff_t)PolyCheckedPrimes[index]);
+
+    poly_exp_t count = job->compose ? job->count : 1;
+    Poly p = PolyReduce(job->p);
+    Poly *args = malloc(sizeof(Poly) * count);
+    assert(args != NULL);
+    for (poly_exp_t i = 0; i < count; ++i)
+        args[i] = PolyReduce(job->args + i);
+    Poly residue = PolyCheckedApply(job, &p, args);
+    Poly expected = PolyReduce(job->wrapped);
+    if (!PolyIsEq(&residue, &expected))
+        atomic_store(&job->overflow, true);
+
+    PolyDestroy(&p);
+    for (poly_exp_t i = 0; i < count; ++i)
+        PolyDestroy(args + i);
+    free(args);
+    PolyDestroy(&residue);
+    PolyDestroy(&expected);
+    PolyModular = saved;
 }
 
 
-Poly PolyCompose(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs)
+/**
+ * Wykonuje działanie, sprawdzając, czy współczynniki wyniku mieszczą się w <c>poly_coeff_t</c>.
+ * Wynik \f$ W \f$ jest liczony w zwykłej arytmetyce, czyli modulo \f$ 2^{w} \f$ (<c>w = POLY_COEFF_BITS</c>).
+ * Prawdziwy wynik \f$ T \f$ różni się od niego (na każdym współczynniku) o mniej niż \f$ 2^{b} + 2^{w - 1} \f$, gdzie
+ * \f$ b \f$ to PolyCheckedBits(). Jeśli \f$ T \equiv W \f$ także modulo liczb pierwszych, których iloczyn razy
+ * \f$ 2^{w} \f$ przekracza tę różnicę, to z chińskiego twierdzenia o resztach \f$ T = W \f$. Wyniki modulo kolejnych
+ * liczb pierwszych są liczone równolegle. Gdy oszacowanie wymaga więcej niż <c>POLY_CHECKED_MAX_PRIMES</c> modułów,
+ * działanie jest wykonywane w trybie dokładnym.
+ * @param job działanie
+ * @param out miejsce na wynik
+ * @return <c>false</c>, gdy wynik nie mieści się w <c>poly_coeff_t</c> (wtedy <c>out</c> nie jest zmieniany)
+ */
+static bool PolyApplyChecked(PolyCheckedJob *job, Poly *out)
 {
-    if (PolyIsCoeff(p))
-        return PolyClone(p);
-    if (vars_subs_count == 0)
-        return ExactCoefficient(p);
-
-    Poly result = PolyZero();
-    for (poly_exp_t i = 0; i < p->length; ++i) {
-        Poly composed_coef = PolyCompose(&p->monos[i].p, vars_subs_count - 1, vars_subs + 1);
+    if (PolyModular.modulus != 0) {
+        *out = PolyCheckedApply(job, job->p, job->args);
+        return true;
+    }
 
-        if (!PolyIsZero(&composed_coef)) {
-            Poly cpow = PolyQuickPower(vars_subs + 0, p->monos[i].exp);
-            Poly composed_mono = PolyMul(&cpow, &composed_coef);
-            Poly new_result = PolyAdd(&result, &composed_mono);
-            PolyDestroy(&cpow);
-            PolyDestroy(&composed_mono);
+    uint64_t bits = PolyExactCoefficients ? 0 : PolyCheckedBits(job);
+    uint64_t primes = 0;
+    if (bits >= POLY_COEFF_BITS)
+        primes = (bits - POLY_COEFF_BITS + POLY_CHECKED_PRIME_BITS) / POLY_CHECKED_PRIME_BITS;
+    if (PolyExactCoefficients || primes > POLY_CHECKED_MAX_PRIMES) {
+        bool saved = PolyExactCoefficients;
+        PolyExactCoefficients = true;
+        Poly result = PolyCheckedApply(job, job->p, job->args);
+        PolyExactCoefficients = saved;
+        if (PolyHasBigCoeff(&result)) {
             PolyDestroy(&result);
-            result = new_result;
+            return false;
         }
+        *out = result;
+        return true;
+    }
 
-        PolyDestroy(&composed_coef);
+    Poly wrapped = PolyCheckedApply(job, job->p, job->args);
+    if (primes > 0) {
+        job->wrapped = &wrapped;
+        atomic_init(&job->overflow, false);
+        PolyParallelFor(primes, PolyCheckedResidueTask, job);
+        if (atomic_load(&job->overflow)) {
+            PolyDestroy(&wrapped);
+            return false;
+        }
     }
+    *out = wrapped;
+    return true;
+}
 
-    return result;
+
+bool PolyMulChecked(const Poly *p, const Poly *q, Poly *out)
+{
+    //Akumulatory liści same wykrywają współczynniki spoza poly_coeff_t
+    if (PolyModular.modulus == 0 && PolyIsLeaf(p) && PolyIsLeaf(q))
+        return PolyMulLeaves(p, q, true, out);
+
+    PolyCheckedJob job = {
+            .p = p,
+            .count = 1,
+            .args = q,
+            .compose = false,
+    };
+    return PolyApplyChecked(&job, out);
+}
+
+
+bool PolyComposeChecked(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs, Poly *out)
+{
+    PolyCheckedJob job = {
+            .p = p,
+            .count = vars_subs_count,
+            .args = vars_subs,
+            .compose = true,
+    };
+    return PolyApplyChecked(&job, out);
 }
@@ -9,27 +9,133 @@
 #ifndef __POLY_H__
 #define __POLY_H__
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
+#ifndef POLY_COEFF_BITS
+/** Szerokość współczynników w bitach (64 albo 32); ustawiana przy kompilacji, np. <c>-DPOLY_COEFF_BITS=32</c> */
+#define POLY_COEFF_BITS 64
+#endif
+
+#if POLY_COEFF_BITS == 64
 /** Typ współczynników wielomianu */
 typedef long poly_coeff_t;
 
+/** Największy współczynnik */
+#define POLY_COEFF_MAX LONG_MAX
+
+/** Najmniejszy współczynnik */
+#define POLY_COEFF_MIN LONG_MIN
+
+#ifdef POLY_COMPACT_MONO
+/** Współczynnik dzieli słowo ze wskaźnikiem, więc wielomian zajmuje 12 bajtów, a jednomian 16 zamiast 24 */
+#define POLY_PACKED __attribute__((packed, aligned(4)))
+#else
+/** Wąskie współczynniki nie wymagają zmiany układu struktury wielomianu */
+#define POLY_PACKED
+#endif
+#elif POLY_COEFF_BITS == 32
+typedef int32_t poly_coeff_t;
+#define POLY_COEFF_MAX INT32_MAX
+#define POLY_COEFF_MIN INT32_MIN
+/** Bez wyrównania do 8 bajtów wielomian zajmuje 12 bajtów, a jednomian 16 zamiast 24 */
+#define POLY_PACKED __attribute__((packed, aligned(4)))
+#ifdef POLY_COMPACT_MONO
+#error "POLY_COMPACT_MONO ma sens tylko przy POLY_COEFF_BITS == 64; wąski jednomian już zajmuje 16 bajtów"
+#endif
+#else
+#error "POLY_COEFF_BITS musi być równe 64 albo 32"
+#endif
+
 /** Typ wykładników wielomianu */
 typedef int poly_exp_t;
 
+#ifdef POLY_SYMBOL_PREFIX
+/** Skleja prefiks wariantu z nazwą funkcji */
+#define POLY_CONCAT_(prefix, name) prefix##name
+/** Skleja prefiks wariantu z nazwą funkcji po rozwinięciu makr w argumentach */
+#define POLY_CONCAT(prefix, name) POLY_CONCAT_(prefix, name)
+/** Nazwa funkcji w wariancie z prefiksem <c>POLY_SYMBOL_PREFIX</c> */
+#define POLY_PREFIXED(name) POLY_CONCAT(POLY_SYMBOL_PREFIX, name)
+
+//Warianty o różnych szerokościach mogą być linkowane razem, jeśli mają różne prefiksy
+#define PolyDestroy POLY_PREFIXED(PolyDestroy)
+#define PolyClone POLY_PREFIXED(PolyClone)
+#define PolyAdd POLY_PREFIXED(PolyAdd)
+#define PolyAddMonos POLY_PREFIXED(PolyAddMonos)
+#define PolyAddCopiedMonos POLY_PREFIXED(PolyAddCopiedMonos)
+#define PolyMul POLY_PREFIXED(PolyMul)
+#define PolyNeg POLY_PREFIXED(PolyNeg)
+#define PolySub POLY_PREFIXED(PolySub)
+#define PolyDegBy POLY_PREFIXED(PolyDegBy)
+#define PolyDeg POLY_PREFIXED(PolyDeg)
+#define PolyIsEq POLY_PREFIXED(PolyIsEq)
+#define PolyHash POLY_PREFIXED(PolyHash)
+#define PolyIsEqProbable POLY_PREFIXED(PolyIsEqProbable)
+#define PolyAt POLY_PREFIXED(PolyAt)
+#define PolyScaleInplace POLY_PREFIXED(PolyScaleInplace)
+#define PolyCompose POLY_PREFIXED(PolyCompose)
+#define PolyShift POLY_PREFIXED(PolyShift)
+#define PolyPow POLY_PREFIXED(PolyPow)
+#define PolySetThreadCount POLY_PREFIXED(PolySetThreadCount)
+#define PolyIsValidModulus POLY_PREFIXED(PolyIsValidModulus)
+#define PolySetModulus POLY_PREFIXED(PolySetModulus)
+#define PolyGetModulus POLY_PREFIXED(PolyGetModulus)
+#define PolySetExactCoefficients POLY_PREFIXED(PolySetExactCoefficients)
+#define PolyReduce POLY_PREFIXED(PolyReduce)
+#define PolyIntern POLY_PREFIXED(PolyIntern)
+#define PolySetCacheBudget POLY_PREFIXED(PolySetCacheBudget)
+#define PolySetCacheBypass POLY_PREFIXED(PolySetCacheBypass)
+#define PolyCacheClear POLY_PREFIXED(PolyCacheClear)
+#define PolyGetCacheStats POLY_PREFIXED(PolyGetCacheStats)
+#define PolyMulChecked POLY_PREFIXED(PolyMulChecked)
+#define PolyComposeChecked POLY_PREFIXED(PolyComposeChecked)
+#define PolyArenaBegin POLY_PREFIXED(PolyArenaBegin)
+#define PolyArenaEnd POLY_PREFIXED(PolyArenaEnd)
+#define PolyPrint POLY_PREFIXED(PolyPrint)
+#define PolyFreeze POLY_PREFIXED(PolyFreeze)
+#define PolyThaw POLY_PREFIXED(PolyThaw)
+#define PolyFrozenClone POLY_PREFIXED(PolyFrozenClone)
+#define PolyFrozenDestroy POLY_PREFIXED(PolyFrozenDestroy)
+#define PolyFrozenIsEq POLY_PREFIXED(PolyFrozenIsEq)
+#define PolyFrozenHash POLY_PREFIXED(PolyFrozenHash)
+#define PolyFrozenDeg POLY_PREFIXED(PolyFrozenDeg)
+#define PolyFrozenDegBy POLY_PREFIXED(PolyFrozenDegBy)
+#define PolyFrozenPrint POLY_PREFIXED(PolyFrozenPrint)
+#endif
+
 /**
  * Struktura przechowująca wielomian
  *
  * Biblioteka nie alokuje pamięci bezpośrednio na instancje jej struktury, tylko na jej dane w razie ptrzeby. W związku
  * z tym wszystkie funkcje usuwające ją z pamięci usuną jedynie jej dane.
  */
-typedef struct Poly
+#ifdef POLY_COMPACT_MONO
+typedef struct POLY_PACKED Poly
+{
+    union
+    {
+        ///Wskaźnik na jednomiany wielomianu (albo na cyfry dużego współczynnika), gdy <c>length != 0</c>
+        struct Mono *monos;
+
+        ///Stała wartość wielomianu, gdy <c>length == 0</c>
+        poly_coeff_t asCoef;
+    };
+
+    ///Liczba jednomianów w wielomianie; 0, kiedy wielomian jest współczynnikiem (wartość w <c>asCoef</c>), a liczba
+    ///ujemna dla dużego współczynnika. Razem z wykładnikiem jednomianu zajmuje jedno 8-bajtowe słowo.
+    poly_exp_t length;
+} Poly;
+#else
+typedef struct POLY_PACKED Poly
 {
     ///Wskaźnik na jednomiany wielomianu; <c>NULL</c>, kiedy wielomian jest stały ze względu na wszystkie zmienne
-    ///(aka ,,jest współczynnikiem'').
+    ///(aka ,,jest współczynnikiem''). Tablicę przydziela biblioteka i może ją współdzielić kilka wielomianów.
+    ///Współczynnik, który nie mieści się w <c>poly_coeff_t</c> (tylko w trybie PolySetExactCoefficients()), ma tu
+    ///wskaźnik na swoje cyfry, a w polu <c>length</c> liczbę ujemną.
     struct Mono *monos;
     union
     {
@@ -37,9 +143,11 @@ typedef struct Poly
         poly_coeff_t asCoef;
 
         ///Zawiera prawidłowe dane, tylko gdy <c>monos != NULL</c>. Wówczas zawiera liczbę jednomianów w wielomianie
+        ///(albo liczbę ujemną dla dużego współczynnika)
         poly_exp_t length;
     };
 } Poly;
+#endif
 
 /**
   * Struktura przechowująca jednomian
@@ -60,7 +168,9 @@ typedef struct Mono
 void PolyDestroy(Poly *p);
 
 /**
- * Robi pełną, głęboką kopię wielomianu.
+ * Robi kopię wielomianu w czasie stałym.
+ * Kopia współdzieli z oryginałem tablicę jednomianów (z licznikiem odwołań); funkcje biblioteki, które zmieniają
+ * wielomian w miejscu (PolyScaleInplace()), najpierw kopiują współdzielone tablice na zmienianej ścieżce.
  * @param[in] p : wielomian
  * @return skopiowany wielomian
  */
@@ -143,6 +253,29 @@ poly_exp_t PolyDeg(const Poly *p);
  */
 bool PolyIsEq(const Poly *p, const Poly *q);
 
+/**
+ * Wylicza skrót (hash) wielomianu.
+ * Skrót zależy tylko od postaci kanonicznej wielomianu: jednomiany o zerowych współczynnikach są pomijane, a
+ * wielomian złożony z jednego jednomianu stopnia 0 o stałym współczynniku ma skrót tego współczynnika. Dlatego
+ * wielomiany równe według PolyIsEq() mają równe skróty, a różne skróty oznaczają różne wielomiany.
+ * @param p wielomian
+ * @return skrót wielomianu
+ */
+uint64_t PolyHash(const Poly *p);
+
+/**
+ * Probabilistycznie sprawdza równość dwóch wielomianów (lemat Schwartza-Zippela).
+ * W każdej rundzie oba wielomiany są wartościowane w losowym punkcie modulo \f$ 2^{61} - 1 \f$ (każda zmienna
+ * dostaje losową wartość), bez alokowania pamięci. Równe wielomiany zawsze dają <c>true</c>; dla różnych
+ * wielomianów stopnia \f$ d \f$ prawdopodobieństwo błędnej odpowiedzi nie przekracza
+ * \f$ ((d + 1) / 2^{61})^\text{rounds} \f$.
+ * @param p wielomian
+ * @param q wielomian
+ * @param rounds liczba niezależnych rund
+ * @return <c>false</c>, gdy wielomiany na pewno są różne; <c>true</c>, gdy z dużym prawdopodobieństwem są równe
+ */
+bool PolyIsEqProbable(const Poly *p, const Poly *q, unsigned rounds);
+
 /**
  * Wylicza wartość wielomianu w punkcie @p x.
  * Wstawia pod pierwszą zmienną wielomianu wartość @p x.
@@ -176,6 +309,176 @@ void PolyScaleInplace(Poly *p, poly_coeff_t scalar);
  */
 Poly PolyCompose(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs);
 
+/**
+ * Przesuwa wielomian względem zmiennej głównej (przesunięcie Taylora).
+ * Używa algorytmu ,,dziel i zwyciężaj'': dzieli wykładniki na połówki i skleja wyniki mnożąc przez potęgi
+ * \f$ (x_0 + a)^{2^i} \f$, zamiast podnosić dwumian do potęgi osobno dla każdego jednomianu.
+ * @param p przesuwany wielomian
+ * @param a przesunięcie
+ * @return wielomian \f$ p(x_0 + a, x_1, x_2, \ldots) \f$
+ */
+Poly PolyShift(const Poly *p, poly_coeff_t a);
+
+/**
+ * Podnosi wielomian do potęgi.
+ * Algorytm jest dobierany na podstawie kształtu wielomianu: jednomiany i wielomiany o kilku wyrazach są rozwijane
+ * wzorem wielomianowym, gęste wielomiany jednej zmiennej o stałych współczynnikach potęgowane rekurencją
+ * J.C.P. Millera, rzadkie wielomiany mnożone wielokrotnie przez podstawę, a pozostałe podnoszone do kwadratu.
+ * @param p potęgowany wielomian
+ * @param exp wykładnik (nieujemny)
+ * @return wielomian \f$ p^\text{exp} \f$
+ */
+Poly PolyPow(const Poly *p, poly_exp_t exp);
+
+/**
+ * Ustawia liczbę wątków używanych przez równoległe algorytmy biblioteki (np. przez PolyCompose()).
+ * @param threads liczba wątków; 0 oznacza liczbę dostępnych procesorów (wartość domyślna)
+ */
+void PolySetThreadCount(unsigned threads);
+
+/**
+ * Sprawdza, czy liczba może być modułem arytmetyki współczynników (PolySetModulus()).
+ * @param modulus sprawdzana liczba
+ * @return <c>true</c> dla 0 oraz dla nieparzystych liczb pierwszych mniejszych od \f$ 2^{62} \f$
+ */
+bool PolyIsValidModulus(poly_coeff_t modulus);
+
+/**
+ * Przełącza arytmetykę współczynników na arytmetykę modulo liczba pierwsza.
+ * Od tej chwili PolyAdd(), PolyMul(), PolyNeg(), PolyScaleInplace(), PolyAt(), PolyCompose(), PolyShift() i
+ * PolyPow() liczą współczynniki modulo <c>modulus</c> (mnożenie Montgomery'ego, bez dzielenia) i zwracają je z
+ * przedziału \f$ [0, \text{modulus}) \f$. Wielomiany przekazywane tym funkcjom muszą mieć zredukowane współczynniki
+ * (PolyReduce()); skalary są redukowane przez same funkcje. Moduł dotyczy tylko wątku wywołującego (i wątków, które
+ * biblioteka uruchamia na jego potrzeby).
+ * @param modulus moduł spełniający PolyIsValidModulus(); 0 przywraca zwykłą arytmetykę z przepełnieniami
+ */
+void PolySetModulus(poly_coeff_t modulus);
+
+/**
+ * Zwraca moduł arytmetyki współczynników.
+ * @return moduł ustawiony przez PolySetModulus(); 0, gdy arytmetyka nie jest modularna
+ */
+poly_coeff_t PolyGetModulus(void);
+
+/**
+ * Włącza lub wyłącza dokładną arytmetykę współczynników.
+ * W trybie dokładnym współczynnik, który nie mieści się w <c>poly_coeff_t</c>, jest przechowywany jako liczba
+ * dowolnej precyzji (w tablicy cyfr na stercie); współczynniki mieszczące się w <c>poly_coeff_t</c> pozostają w polu
+ * <c>asCoef</c> i nie wymagają alokacji. Bez trybu dokładnego współczynniki się przepełniają (zawijają). Moduł
+ * ustawiony przez PolySetModulus() ma pierwszeństwo przed trybem dokładnym. Przed wyłączeniem trybu dokładnego duże
+ * współczynniki należy zawinąć funkcją PolyReduce(). Tryb dotyczy tylko wątku wywołującego.
+ * @param exact czy włączyć tryb dokładny
+ */
+void PolySetExactCoefficients(bool exact);
+
+/**
+ * Zwraca kopię wielomianu ze współczynnikami sprowadzonymi do bieżącej arytmetyki.
+ * Z modułem (PolySetModulus()) współczynniki trafiają do przedziału \f$ [0, \text{modulus}) \f$; bez modułu i bez
+ * trybu dokładnego (PolySetExactCoefficients()) duże współczynniki są zawijane do <c>poly_coeff_t</c>. Jednomiany,
+ * których współczynniki stały się zerami, są usuwane.
+ * @param p wielomian
+ * @return zredukowany wielomian
+ */
+Poly PolyReduce(const Poly *p);
+
+/**
+ * Zwraca internowaną kopię wielomianu.
+ * Tablice jednomianów postaci kanonicznej są wyszukiwane w globalnej tablicy internowania i współdzielone, więc
+ * równe podwielomiany (także w różnych wielomianach) zajmują pamięć tylko raz, a PolyIsEq() porównuje dwa internowane
+ * wielomiany po adresie. Wpis znika z tablicy razem z ostatnim odwołaniem do tablicy jednomianów. W zakresie areny
+ * (PolyArenaBegin()) wielomiany nie są internowane.
+ * @param p wielomian
+ * @return internowany wielomian równy <c>p</c> (lub kopia <c>p</c>, gdy nie jest on w postaci kanonicznej)
+ */
+Poly PolyIntern(const Poly *p);
+
+/**
+ * Statystyki pamięci podręcznej działań (PolyGetCacheStats()).
+ */
+typedef struct PolyCacheStats
+{
+    ///Liczba wyników znalezionych w pamięci podręcznej od początku działania programu
+    uint64_t hits;
+
+    ///Liczba wyszukiwań zakończonych niepowodzeniem od początku działania programu
+    uint64_t misses;
+
+    ///Liczba zapamiętanych wyników
+    size_t entries;
+
+    ///Szacowana pamięć zajmowana przez zapamiętane wyniki, w bajtach
+    size_t bytes;
+} PolyCacheStats;
+
+/**
+ * Ustawia budżet pamięci podręcznej działań.
+ * PolyAdd(), PolyMul() i PolyPow() zapamiętują wyniki dla argumentów internowanych (PolyIntern()), rozpoznając je po
+ * adresach tablic jednomianów; zapamiętane wyniki też są internowane. Gdy pamięć podręczna przekroczy budżet, usuwane
+ * są najdawniej użyte wyniki. Domyślny budżet to 64 MiB.
+ * @param bytes budżet w bajtach; 0 wyłącza zapamiętywanie (już zapamiętane wyniki są usuwane)
+ */
+void PolySetCacheBudget(size_t bytes);
+
+/**
+ * Włącza lub wyłącza omijanie pamięci podręcznej działań w bieżącym wątku (i wątkach, które biblioteka uruchamia na
+ * jego potrzeby), np. na czas pojedynczego wywołania.
+ * @param bypass czy omijać pamięć podręczną
+ * @return poprzednie ustawienie
+ */
+bool PolySetCacheBypass(bool bypass);
+
+/**
+ * Usuwa wszystkie wyniki z pamięci podręcznej działań wraz z ich odwołaniami do wielomianów. Liczniki trafień i
+ * chybień nie są zerowane.
+ */
+void PolyCacheClear(void);
+
+/**
+ * Zwraca statystyki pamięci podręcznej działań.
+ * @return statystyki
+ */
+PolyCacheStats PolyGetCacheStats(void);
+
+/**
+ * Mnoży wielomiany, wykrywając przepełnienie.
+ * Wynik jest liczony w arytmetyce <c>poly_coeff_t</c>, a gdy jego współczynniki mogą się nie mieścić w
+ * <c>poly_coeff_t</c>, także modulo kilku dużych liczb pierwszych (równolegle, zob. PolySetThreadCount()); z chińskiego
+ * twierdzenia o resztach wynika wtedy, czy wynik jest dokładny. W arytmetyce modularnej (PolySetModulus())
+ * przepełnienie nie występuje.
+ * @param p wielomian
+ * @param q wielomian
+ * @param out miejsce na \f$ p * q \f$
+ * @return <c>false</c>, gdy któryś ze współczynników iloczynu nie mieści się w <c>poly_coeff_t</c> (wtedy <c>out</c>
+ * nie jest zmieniany)
+ */
+bool PolyMulChecked(const Poly *p, const Poly *q, Poly *out);
+
+/**
+ * Składa wielomiany jak PolyCompose(), wykrywając przepełnienie tak jak PolyMulChecked().
+ * @param p wielomian, w którym podstawiamy zmienne
+ * @param vars_subs_count liczba elementów tablicy <c>vars_subs</c>
+ * @param vars_subs tablica z podstawieniami dla kolejnych zmiennych
+ * @param out miejsce na złożenie
+ * @return <c>false</c>, gdy któryś ze współczynników złożenia nie mieści się w <c>poly_coeff_t</c> (wtedy <c>out</c>
+ * nie jest zmieniany)
+ */
+bool PolyComposeChecked(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_subs, Poly *out);
+
+/**
+ * Zaczyna zakres areny w bieżącym wątku.
+ * Do wywołania PolyArenaEnd() krótkie tablice jednomianów tworzonych wielomianów są wydzielane kolejno z areny, a ich
+ * zwalnianie nic nie kosztuje. Przydaje się to przy operacjach, które tworzą wiele tymczasowych wielomianów (np.
+ * PolyCompose(), PolyPow()). Zakresów nie można zagnieżdżać.
+ */
+void PolyArenaBegin(void);
+
+/**
+ * Kończy zakres areny i w czasie stałym zwalnia całą arenę. Wielomian @p result zostaje przeniesiony poza arenę;
+ * wszystkie pozostałe wielomiany utworzone w zakresie areny muszą zostać wcześniej usunięte.
+ * @param[in,out] result wynik, który ma przetrwać zakres areny, albo <c>NULL</c>
+ */
+void PolyArenaEnd(Poly *result);
+
 /**
  * Wypisuje wielomian do podanego w argumencie strumienia.
  * Wypisany wielomian jest zgodny ze specyfikacją zadania, tj:
@@ -189,6 +492,109 @@ Poly PolyCompose(const Poly *p, poly_exp_t vars_subs_count, const Poly *vars_sub
  */
 void PolyPrint(const Poly *p, FILE *stream);
 
+/**
+ * Slot postaci zamrożonej wielomianu (PolyFrozen).
+ * Wielomian niebędący współczynnikiem zajmuje slot nagłówka, po którym następują sloty jego jednomianów, a po nich
+ * kolejno postaci zamrożone podwielomianów tych jednomianów, które nie są współczynnikami (porządek preorder).
+ */
+typedef struct PolyFrozenSlot
+{
+    ///W jednomianie: współczynnik, gdy podwielomian jest współczynnikiem (wpp. 0); w nagłówku: 0
+    poly_coeff_t coef;
+
+    ///W jednomianie: wykładnik; w nagłówku: liczba jednomianów
+    poly_exp_t exp;
+
+    ///W jednomianie: odległość (w slotach) od tego slotu do nagłówka podwielomianu albo 0, gdy podwielomian jest
+    ///współczynnikiem; w nagłówku: 0
+    uint32_t child;
+} PolyFrozenSlot;
+
+/**
+ * Wielomian zamrożony: całe drzewo w jednym buforze, z odległościami zamiast wskaźników (PolyFreeze()).
+ * Postać zamrożona jest kanoniczna (bez zerowych jednomianów; jednomian \f$ c x^0 \f$ jest współczynnikiem \f$ c \f$),
+ * więc równe wielomiany mają identyczne bufory. Nie można w niej przechowywać dużych współczynników
+ * (PolySetExactCoefficients()).
+ */
+typedef struct PolyFrozen
+{
+    ///Bufor slotów zaczynający się od nagłówka wielomianu; <c>NULL</c>, gdy wielomian jest współczynnikiem
+    PolyFrozenSlot *slots;
+    union
+    {
+        ///Zawiera prawidłowe dane, tylko gdy <c>slots == NULL</c>. Wówczas zawiera wartość wielomianu
+        poly_coeff_t coef;
+
+        ///Zawiera prawidłowe dane, tylko gdy <c>slots != NULL</c>. Wówczas zawiera liczbę slotów bufora
+        size_t size;
+    };
+} PolyFrozen;
+
+/**
+ * Zamraża wielomian: zapisuje jego postać kanoniczną w jednym buforze.
+ * @param p wielomian
+ * @param out miejsce na wielomian zamrożony
+ * @return <c>false</c>, gdy wielomian ma duże współczynniki (wtedy <c>out</c> nie jest zmieniany)
+ */
+bool PolyFreeze(const Poly *p, PolyFrozen *out);
+
+/**
+ * Odtwarza wielomian z postaci zamrożonej.
+ * @param f wielomian zamrożony
+ * @return wielomian równy <c>f</c>
+ */
+Poly PolyThaw(const PolyFrozen *f);
+
+/**
+ * Kopiuje wielomian zamrożony (jednym <c>memcpy</c>).
+ * @param f wielomian zamrożony
+ * @return kopia
+ */
+PolyFrozen PolyFrozenClone(const PolyFrozen *f);
+
+/**
+ * Usuwa wielomian zamrożony z pamięci.
+ * @param f wielomian zamrożony
+ */
+void PolyFrozenDestroy(PolyFrozen *f);
+
+/**
+ * Sprawdza równość wielomianów zamrożonych (porównując bufory).
+ * @param p wielomian zamrożony
+ * @param q wielomian zamrożony
+ * @return czy wielomiany są równe
+ */
+bool PolyFrozenIsEq(const PolyFrozen *p, const PolyFrozen *q);
+
+/**
+ * Wylicza skrót wielomianu zamrożonego, równy PolyHash() odtworzonego wielomianu.
+ * @param f wielomian zamrożony
+ * @return skrót
+ */
+uint64_t PolyFrozenHash(const PolyFrozen *f);
+
+/**
+ * Zwraca stopień wielomianu zamrożonego jak PolyDeg().
+ * @param f wielomian zamrożony
+ * @return stopień (-1 dla zera)
+ */
+poly_exp_t PolyFrozenDeg(const PolyFrozen *f);
+
+/**
+ * Zwraca stopień wielomianu zamrożonego ze względu na zmienną jak PolyDegBy().
+ * @param f wielomian zamrożony
+ * @param var_idx indeks zmiennej
+ * @return stopień (-1 dla zera)
+ */
+poly_exp_t PolyFrozenDegBy(const PolyFrozen *f, unsigned var_idx);
+
+/**
+ * Wypisuje wielomian zamrożony tak jak PolyPrint().
+ * @param f wielomian zamrożony
+ * @param stream strumień wyjściowy
+ */
+void PolyFrozenPrint(const PolyFrozen *f, FILE *stream);
+
 /**
  * Robi pełną, głęboką kopię jednomianu.
  * @param[in] m : jednomian
@@ -210,7 +616,11 @@ static inline Mono MonoClone(const Mono *m)
 static inline Poly PolyFromCoeff(poly_coeff_t c)
 {
     Poly p; //Polip
+#ifdef POLY_COMPACT_MONO
+    p.length = 0;
+#else
     p.monos = NULL;
+#endif
     p.asCoef = c;
     return p;
 }
@@ -239,6 +649,21 @@ static inline Mono MonoFromPoly(Poly *p, poly_exp_t e)
     return m;
 }
 
+/**
+ * Sprawdza, czy wielomian jest współczynnikiem mieszczącym się w <c>poly_coeff_t</c> (czyli ma ważne pole
+ * <c>asCoef</c>); nie zależy od układu struktury (<c>POLY_COMPACT_MONO</c>).
+ * @param[in] p : wielomian
+ * @return Czy wielomian jest małym współczynnikiem?
+ */
+static inline bool PolyIsSmallCoeff(const Poly *p)
+{
+#ifdef POLY_COMPACT_MONO
+    return p->length == 0;
+#else
+    return p->monos == NULL;
+#endif
+}
+
 /**
  * Sprawdza, czy wielomian jest współczynnikiem.
  * @param[in] p : wielomian
@@ -246,7 +671,7 @@ static inline Mono MonoFromPoly(Poly *p, poly_exp_t e)
  */
 static inline bool PolyIsCoeff(const Poly *p)
 {
-    return p->monos == NULL;
+    return PolyIsSmallCoeff(p) || p->length < 0;
 }
 
 /**
@@ -256,11 +681,31 @@ static inline bool PolyIsCoeff(const Poly *p)
  */
 static inline bool PolyIsZero(const Poly *p)
 {
-    if (p->monos == NULL)
+    if (PolyIsSmallCoeff(p))
         return p->asCoef == 0;
     return false;
 }
 
+/**
+ * Sprawdza, czy wielomian zamrożony jest współczynnikiem.
+ * @param[in] f : wielomian zamrożony
+ * @return Czy wielomian jest współczynnikiem?
+ */
+static inline bool PolyFrozenIsCoeff(const PolyFrozen *f)
+{
+    return f->slots == NULL;
+}
+
+/**
+ * Sprawdza, czy wielomian zamrożony jest tożsamościowo równy zeru.
+ * @param[in] f : wielomian zamrożony
+ * @return Czy wielomian jest równy zero?
+ */
+static inline bool PolyFrozenIsZero(const PolyFrozen *f)
+{
+    return f->slots == NULL && f->coef == 0;
+}
+
 /**
  * Usuwa jednomian z pamięci.
  * @param[in] m : jednomian
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <setjmp.h>
+#include <pthread.h>
 #include <cmocka.h>
 #include "poly.h"
 
@@ -460,6 +461,1381 @@ static void TestPolyComposeLinLin(void **state)
 }
 
 
+/**
+ * Tworzy wielomian \f$ c \cdot x_\text{var}^\text{exp} \f$.
+ * @param c współczynnik
+ * @param var indeks zmiennej
+ * @param exp wykładnik
+ * @return jednomian jako wielomian
+ */
+static Poly MakeMonomial(poly_coeff_t c, unsigned var, poly_exp_t exp)
+{
+    Poly p = PolyFromCoeff(c);
+    Mono m = MonoFromPoly(&p, exp);
+    p = PolyAddMonos(1, &m);
+    for (unsigned i = 0; i < var; ++i) {
+        m = MonoFromPoly(&p, 0);
+        p = PolyAddMonos(1, &m);
+    }
+    return p;
+}
+
+
+/**
+ * Tworzy wielomian \f$ 5 + 3 x_0 x_1^2 + x_0^2 \f$, używany w testach szybkich ścieżek PolyCompose().
+ * @return wielomian
+ */
+static Poly MakeComposeSample()
+{
+    Poly five = PolyFromCoeff(5);
+    Poly x1_sq = MakeMonomial(3, 0, 2);
+    Poly one = PolyFromCoeff(1);
+    Mono monos[] = {MonoFromPoly(&five, 0), MonoFromPoly(&x1_sq, 1), MonoFromPoly(&one, 2)};
+    return PolyAddMonos(3, monos);
+}
+
+
+/**
+ * Porównuje szybką ścieżkę PolyCompose() z wynikiem złożenia policzonym ręcznie.
+ * Niszczy wszystkie argumenty.
+ * @param p składany wielomian
+ * @param count liczba podstawień
+ * @param x podstawienia
+ * @param expect oczekiwany wynik
+ */
+static void CheckCompose(Poly p, poly_exp_t count, Poly *x, Poly expect)
+{
+    Poly got = PolyCompose(&p, count, x);
+    assert_true(PolyIsEq(&got, &expect));
+
+    PolyDestroy(&p);
+    PolyDestroy(&expect);
+    PolyDestroy(&got);
+    for (poly_exp_t i = 0; i < count; ++i)
+        PolyDestroy(x + i);
+}
+
+
+/**
+ * Wszystkie podstawienia stałe, w tym zero (\f$ 0^0 = 1 \f$).
+ */
+static void TestPolyComposeConstSubs(void **state)
+{
+    (void)state;
+    CheckCompose(MakeComposeSample(), 2, (Poly[]){PolyFromCoeff(2), PolyFromCoeff(-1)}, PolyFromCoeff(15));
+    CheckCompose(MakeComposeSample(), 2, (Poly[]){PolyZero(), PolyFromCoeff(7)}, PolyFromCoeff(5));
+}
+
+
+/**
+ * Podstawienia jednomianowe \f$ x_0 = 2 x_0^3 \f$, \f$ x_1 = -x_0 \f$.
+ */
+static void TestPolyComposeMonomialSubs(void **state)
+{
+    (void)state;
+    Poly x0_6 = MakeMonomial(4, 0, 6);
+    Poly x0_5 = MakeMonomial(6, 0, 5);
+    Poly five = PolyFromCoeff(5);
+    Poly sum = PolyAdd(&x0_6, &x0_5);
+    Poly expect = PolyAdd(&sum, &five);
+    PolyDestroy(&x0_6);
+    PolyDestroy(&x0_5);
+    PolyDestroy(&sum);
+
+    CheckCompose(MakeComposeSample(), 2, (Poly[]){MakeMonomial(2, 0, 3), MakeMonomial(-1, 0, 1)}, expect);
+}
+
+
+/**
+ * Permutacja zmiennych \f$ x_0 \leftrightarrow x_1 \f$ oraz podstawienie tożsamościowe.
+ */
+static void TestPolyComposePermutation(void **state)
+{
+    (void)state;
+    Poly sample = MakeComposeSample();
+    Poly x[] = {MakeMonomial(1, 1, 1), MakeMonomial(1, 0, 1)};
+    Poly swapped = PolyCompose(&sample, 2, x);
+    Poly back = PolyCompose(&swapped, 2, x);
+    assert_false(PolyIsEq(&swapped, &sample));
+    assert_true(PolyIsEq(&back, &sample));
+    PolyDestroy(&swapped);
+    PolyDestroy(&back);
+    PolyDestroy(&sample);
+    PolyDestroy(x + 0);
+    PolyDestroy(x + 1);
+
+    CheckCompose(MakeComposeSample(), 2, (Poly[]){MakeMonomial(1, 0, 1), MakeMonomial(1, 1, 1)},
+                 MakeComposeSample());
+}
+
+
+/**
+ * Gęste podstawienia dwóch zmiennych, przy których PolyCompose() wybiera ewaluację i interpolację; wynik jest
+ * porównywany ze złożeniem policzonym przez potęgowanie i mnożenie.
+ */
+static void TestPolyComposeDenseSubs(void **state)
+{
+    (void)state;
+
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(1, 1, 1);
+    Poly one = PolyFromCoeff(1);
+    Poly two = PolyFromCoeff(2);
+    Poly x0x1 = PolyMul(&x0, &x1);
+    Poly t1 = PolyAdd(&one, &x0);
+    Poly t2 = PolyAdd(&x1, &x0x1);
+    Poly t3 = PolySub(&two, &x0);
+    Poly x[] = {PolyAdd(&t1, &t2), PolyAdd(&t3, &x1)};
+
+    Poly p = PolyZero();
+    Poly expect = PolyZero();
+    Poly power0 = PolyFromCoeff(1);
+    for (poly_exp_t a = 0; a <= 5; ++a) {
+        Poly power1 = PolyFromCoeff(1);
+        for (poly_exp_t b = 0; b <= 5; ++b) {
+            Poly term = MakeMonomial(a + b + 1, 0, a);
+            Poly inner = MakeMonomial(1, 1, b);
+            Poly full = PolyMul(&term, &inner);
+            Poly sum = PolyAdd(&p, &full);
+            PolyDestroy(&p);
+            p = sum;
+
+            Poly composed = PolyMul(&power0, &power1);
+            PolyScaleInplace(&composed, a + b + 1);
+            sum = PolyAdd(&expect, &composed);
+            PolyDestroy(&expect);
+            expect = sum;
+
+            Poly next = PolyMul(&power1, x + 1);
+            PolyDestroy(&power1);
+            power1 = next;
+            PolyDestroy(&term);
+            PolyDestroy(&inner);
+            PolyDestroy(&full);
+            PolyDestroy(&composed);
+        }
+        Poly next = PolyMul(&power0, x + 0);
+        PolyDestroy(&power0);
+        power0 = next;
+        PolyDestroy(&power1);
+    }
+
+    Poly got = PolyCompose(&p, 2, x);
+    assert_true(PolyIsEq(&got, &expect));
+
+    Poly polys[] = {x0, x1, x0x1, t1, t2, t3, x[0], x[1], p, expect, power0, got};
+    for (size_t i = 0; i < sizeof(polys) / sizeof(polys[0]); ++i)
+        PolyDestroy(polys + i);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_shift
+/**
+ * Przesunięcie \f$ x_0^2 \f$ o 3 i z powrotem.
+ */
+static void TestPolyShiftSquare(void **state)
+{
+    (void)state;
+
+    Poly p = MakeMonomial(1, 0, 2);
+    Poly got = PolyShift(&p, 3);
+    Poly nine = PolyFromCoeff(9);
+    Poly six_x = MakeMonomial(6, 0, 1);
+    Poly partial = PolyAdd(&p, &six_x);
+    Poly expect = PolyAdd(&partial, &nine);
+    assert_true(PolyIsEq(&got, &expect));
+
+    Poly back = PolyShift(&got, -3);
+    assert_true(PolyIsEq(&back, &p));
+
+    PolyDestroy(&p);
+    PolyDestroy(&got);
+    PolyDestroy(&six_x);
+    PolyDestroy(&partial);
+    PolyDestroy(&expect);
+    PolyDestroy(&back);
+}
+
+
+/**
+ * Przesunięcie wielomianu wielu zmiennych zgadza się ze złożeniem z \f$ x_0 + a \f$.
+ */
+static void TestPolyShiftCompose(void **state)
+{
+    (void)state;
+
+    Poly p = MakeComposeSample();
+    Poly shift = PolyFromCoeff(-2);
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x[] = {PolyAdd(&x0, &shift), MakeMonomial(1, 1, 1)};
+    Poly expect = PolyCompose(&p, 2, x);
+    Poly got = PolyShift(&p, -2);
+    assert_true(PolyIsEq(&got, &expect));
+
+    PolyDestroy(&p);
+    PolyDestroy(&x0);
+    PolyDestroy(x + 0);
+    PolyDestroy(x + 1);
+    PolyDestroy(&expect);
+    PolyDestroy(&got);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_pow
+/**
+ * Sprawdza PolyPow() z potęgowaniem przez wielokrotne mnożenie dla wykładników od 0 do <c>max_exp</c>.
+ * Niszczy podstawę.
+ * @param base potęgowany wielomian
+ * @param max_exp największy sprawdzany wykładnik
+ */
+static void CheckPow(Poly base, poly_exp_t max_exp)
+{
+    Poly expect = PolyFromCoeff(1);
+    for (poly_exp_t exp = 0; exp <= max_exp; ++exp) {
+        Poly got = PolyPow(&base, exp);
+        assert_true(PolyIsEq(&got, &expect));
+        PolyDestroy(&got);
+
+        Poly next = PolyMul(&expect, &base);
+        PolyDestroy(&expect);
+        expect = next;
+    }
+    PolyDestroy(&expect);
+    PolyDestroy(&base);
+}
+
+
+/**
+ * Potęgi wielomianów o kilku wyrazach (rozwinięcie wielomianowe).
+ */
+static void TestPolyPowFewTerms(void **state)
+{
+    (void)state;
+
+    CheckPow(MakeMonomial(-3, 2, 4), 9);
+
+    Poly x = MakeMonomial(2, 0, 3);
+    Poly y = MakeMonomial(-1, 1, 2);
+    CheckPow(PolyAdd(&x, &y), 9);
+
+    Poly one = PolyFromCoeff(1);
+    Poly xy = PolyAdd(&x, &y);
+    CheckPow(PolyAdd(&xy, &one), 9);
+
+    PolyDestroy(&x);
+    PolyDestroy(&y);
+    PolyDestroy(&xy);
+}
+
+
+/**
+ * Potęgi gęstych wielomianów jednej zmiennej (rekurencja Millera), także takich, dla których rekurencja
+ * przekracza zakres współczynników.
+ */
+static void TestPolyPowDense(void **state)
+{
+    (void)state;
+
+    Poly p = PolyZero();
+    for (poly_exp_t i = 0; i < 6; ++i) {
+        Poly m = MakeMonomial(i % 2 == 0 ? i + 1 : -i, 0, i + 2);
+        Poly sum = PolyAdd(&p, &m);
+        PolyDestroy(&p);
+        PolyDestroy(&m);
+        p = sum;
+    }
+    Poly big = MakeMonomial((poly_coeff_t)1 << (POLY_COEFF_BITS * 5 / 8), 0, 2);
+    CheckPow(PolyAdd(&p, &big), 4);
+    CheckPow(p, 9);
+    PolyDestroy(&big);
+
+    //Rekurencja dochodzi do sumy POLY_COEFF_MIN dzielonej przez -1
+    const poly_coeff_t coeffs[] = {-1, POLY_COEFF_MIN / 2, 1, 1, 1};
+    Poly q = PolyZero();
+    for (poly_exp_t i = 0; i < 5; ++i) {
+        Poly m = MakeMonomial(coeffs[i], 0, i);
+        Poly sum = PolyAdd(&q, &m);
+        PolyDestroy(&q);
+        PolyDestroy(&m);
+        q = sum;
+    }
+    CheckPow(q, 3);
+}
+
+
+/**
+ * Potęgi rzadkich i gęstych wielomianów wielu zmiennych.
+ */
+static void TestPolyPowMultivariate(void **state)
+{
+    (void)state;
+
+    Poly x = MakeMonomial(1, 0, 1);
+    Poly y = MakeMonomial(1, 1, 1);
+    Poly one = PolyFromCoeff(1);
+    Poly x1 = PolyAdd(&x, &one);
+    Poly y1 = PolyAdd(&y, &one);
+    Poly dense = PolyMul(&x1, &y1);
+    CheckPow(PolyMul(&dense, &x1), 6);
+
+    Poly sparse = PolyZero();
+    for (poly_exp_t i = 0; i < 6; ++i) {
+        Poly a = MakeMonomial(i + 1, 0, 3 * i);
+        Poly b = MakeMonomial(1, 1, 7 - i);
+        Poly m = PolyMul(&a, &b);
+        Poly sum = PolyAdd(&sparse, &m);
+        PolyDestroy(&sparse);
+        PolyDestroy(&a);
+        PolyDestroy(&b);
+        PolyDestroy(&m);
+        sparse = sum;
+    }
+    CheckPow(sparse, 6);
+
+    PolyDestroy(&x);
+    PolyDestroy(&y);
+    PolyDestroy(&x1);
+    PolyDestroy(&y1);
+    PolyDestroy(&dense);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_add_monos
+/**
+ * PolyAddMonos() dla długiej, nieposortowanej tablicy z powtarzającymi się (także dużymi) wykładnikami.
+ */
+static void TestPolyAddMonosUnsorted(void **state)
+{
+    (void)state;
+
+    const poly_exp_t distinct = 500;
+    Mono monos[2 * 500];
+    for (poly_exp_t i = 0; i < 2 * distinct; ++i) {
+        poly_exp_t k = (i * 7919) % distinct;
+        Poly coef = k % 3 == 0 ? MakeMonomial(1, 0, 1) : PolyFromCoeff(1);
+        monos[i] = MonoFromPoly(&coef, k * 4000037);
+    }
+    Poly p = PolyAddMonos(2 * distinct, monos);
+
+    assert_int_equal(p.length, distinct);
+    for (poly_exp_t i = 0; i < distinct; ++i) {
+        if (i > 0)
+            assert_true(p.monos[i - 1].exp < p.monos[i].exp);
+        if (PolyIsCoeff(&p.monos[i].p)) {
+            assert_int_equal(p.monos[i].p.asCoef, 2);
+        } else {
+            assert_int_equal(p.monos[i].p.length, 1);
+            assert_int_equal(p.monos[i].p.monos[0].exp, 1);
+            assert_int_equal(p.monos[i].p.monos[0].p.asCoef, 2);
+        }
+    }
+
+    PolyDestroy(&p);
+}
+
+
+/**
+ * PolyAddMonos() dla tablicy złożonej z kilku posortowanych serii, z powtórzeniami wewnątrz serii i pomiędzy nimi.
+ */
+static void TestPolyAddMonosRuns(void **state)
+{
+    (void)state;
+
+    const poly_exp_t exps[] = {0, 2, 2, 5, 9, 1, 2, 9, 10, 0, 0, 3, 7, 7, 11};
+    const poly_exp_t expected_exps[] = {0, 1, 2, 3, 5, 7, 9, 10, 11};
+    const poly_coeff_t expected_coefs[] = {3, 1, 3, 1, 1, 2, 2, 1, 1};
+    Mono monos[15];
+    for (size_t i = 0; i < 15; ++i) {
+        Poly coef = PolyFromCoeff(1);
+        monos[i] = MonoFromPoly(&coef, exps[i]);
+    }
+    Poly p = PolyAddMonos(15, monos);
+
+    assert_int_equal(p.length, 9);
+    for (poly_exp_t i = 0; i < 9; ++i) {
+        assert_int_equal(p.monos[i].exp, expected_exps[i]);
+        assert_int_equal(p.monos[i].p.asCoef, expected_coefs[i]);
+    }
+
+    PolyDestroy(&p);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_hash
+/**
+ * Tworzy niekanoniczny wielomian \f$ c + 0 \cdot x_0^e \f$.
+ * @param c wyraz wolny
+ * @param exp wykładnik zerowego jednomianu
+ * @return wielomian
+ */
+static Poly MakeWithZeroMono(poly_coeff_t c, poly_exp_t exp)
+{
+    //Tablicę jednomianów musi przydzielić biblioteka, więc zaczynamy od \f$ 1 + x_0^e \f$ i podmieniamy współczynniki
+    Mono monos[] = {{.p = PolyFromCoeff(1), .exp = 0}, {.p = PolyFromCoeff(1), .exp = exp}};
+    Poly p = PolyAddMonos(2, monos);
+    assert_int_equal(p.length, 2);
+    p.monos[0].p = PolyFromCoeff(c);
+    p.monos[1].p = PolyZero();
+    return p;
+}
+
+
+/**
+ * Skróty niekanonicznych postaci są równe skrótom postaci kanonicznych.
+ */
+static void TestPolyHashCanonical(void **state)
+{
+    (void)state;
+
+    Poly five = PolyFromCoeff(5);
+    Poly five_zero = MakeWithZeroMono(5, 3);
+    assert_true(PolyIsEq(&five, &five_zero));
+    assert_true(PolyIsEq(&five_zero, &five));
+    assert_true(PolyHash(&five) == PolyHash(&five_zero));
+
+    Poly zero = PolyZero();
+    Poly zero_zero = MakeWithZeroMono(0, 7);
+    assert_true(PolyHash(&zero) == PolyHash(&zero_zero));
+
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x0_zero = MakeWithZeroMono(0, 5);
+    PolyDestroy(&x0_zero.monos[0].p);
+    x0_zero.monos[0] = (Mono){.p = PolyFromCoeff(1), .exp = 1};
+    assert_true(PolyIsEq(&x0, &x0_zero));
+    assert_true(PolyIsEq(&x0_zero, &x0));
+    assert_true(PolyHash(&x0) == PolyHash(&x0_zero));
+
+    PolyDestroy(&five);
+    PolyDestroy(&five_zero);
+    PolyDestroy(&zero);
+    PolyDestroy(&zero_zero);
+    PolyDestroy(&x0);
+    PolyDestroy(&x0_zero);
+}
+
+
+/**
+ * Skróty różnych wielomianów są różne, także gdy wielomiany różnią się tylko zmienną.
+ */
+static void TestPolyHashDistinct(void **state)
+{
+    (void)state;
+
+    Poly polys[] = {
+            PolyFromCoeff(1),
+            PolyFromCoeff(-1),
+            MakeMonomial(1, 0, 1),
+            MakeMonomial(1, 1, 1),
+            MakeMonomial(1, 0, 2),
+            MakeMonomial(2, 0, 1),
+            MakeComposeSample(),
+    };
+    const size_t count = sizeof(polys) / sizeof(Poly);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 1; j < count; ++j)
+            assert_true(PolyHash(polys + i) != PolyHash(polys + j));
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        PolyDestroy(polys + i);
+}
+
+
+/**
+ * PolyIsEqProbable() odróżnia wielomiany różniące się jednym współczynnikiem (także o wielokrotność modułu
+ * \f$ 2^{61} - 1 \f$) i utożsamia niekanoniczne postaci tego samego wielomianu.
+ */
+static void TestPolyIsEqProbable(void **state)
+{
+    (void)state;
+
+    Poly p = MakeComposeSample();
+    Poly q = MakeComposeSample();
+    assert_true(PolyIsEqProbable(&p, &q, 4));
+
+    Poly shift = PolyFromCoeff(POLY_COEFF_MAX);
+    Poly shifted = PolyAdd(&q, &shift);
+    assert_false(PolyIsEqProbable(&p, &shifted, 4));
+
+    Poly five = PolyFromCoeff(5);
+    Poly five_zero = MakeWithZeroMono(5, 3);
+    assert_true(PolyIsEqProbable(&five, &five_zero, 4));
+
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(1, 1, 1);
+    assert_false(PolyIsEqProbable(&x0, &x1, 4));
+
+    //Duży współczynnik -POLY_COEFF_MIN ma te same bity co mały POLY_COEFF_MIN, ale inną wartość
+    PolySetExactCoefficients(true);
+    Poly max = PolyFromCoeff(POLY_COEFF_MAX);
+    Poly one = PolyFromCoeff(1);
+    Poly min = PolyFromCoeff(POLY_COEFF_MIN);
+    Poly big = PolyAdd(&max, &one);
+    Poly negated_min = PolyNeg(&min);
+    assert_false(PolyIsEqProbable(&big, &min, 4));
+    assert_true(PolyIsEqProbable(&big, &negated_min, 4));
+    PolySetExactCoefficients(false);
+
+    PolyDestroy(&big);
+    PolyDestroy(&negated_min);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&shift);
+    PolyDestroy(&shifted);
+    PolyDestroy(&five);
+    PolyDestroy(&five_zero);
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_modular
+/**
+ * Poprawne i niepoprawne moduły.
+ */
+static void TestPolyModulusValid(void **state)
+{
+    (void)state;
+
+    assert_true(PolyIsValidModulus(0));
+    assert_true(PolyIsValidModulus(3));
+    assert_true(PolyIsValidModulus(1000003));
+#if POLY_COEFF_BITS == 64
+    assert_true(PolyIsValidModulus(((poly_coeff_t)1 << 61) - 1));
+#else
+    assert_true(PolyIsValidModulus(POLY_COEFF_MAX)); //2^31 - 1 jest liczbą pierwszą
+#endif
+    assert_false(PolyIsValidModulus(-7));
+    assert_false(PolyIsValidModulus(1));
+    assert_false(PolyIsValidModulus(2));
+    assert_false(PolyIsValidModulus(9));
+#if POLY_COEFF_BITS == 64
+    assert_false(PolyIsValidModulus(3215031751)); //silnie pseudopierwsza przy podstawach 2, 3, 5 i 7
+    assert_false(PolyIsValidModulus(((poly_coeff_t)1 << 62) + 135)); //liczba pierwsza, ale za duża
+#else
+    assert_false(PolyIsValidModulus(25326001)); //silnie pseudopierwsza przy podstawach 2, 3 i 5
+#endif
+}
+
+
+/**
+ * Działania modulo 7: wyniki są redukowane, a jednomiany o zerowych współczynnikach znikają.
+ */
+static void TestPolyModularArithmetic(void **state)
+{
+    (void)state;
+    PolySetModulus(7);
+
+    Poly x0_plus_6 = MakeMonomial(1, 0, 1);
+    Poly six = PolyFromCoeff(6);
+    Poly tmp = PolyAdd(&x0_plus_6, &six);
+    PolyDestroy(&x0_plus_6);
+    x0_plus_6 = tmp;
+    Poly two = PolyFromCoeff(2);
+    Poly x0_plus_1 = PolyAdd(&x0_plus_6, &two);
+    Poly negated = PolyNeg(&x0_plus_1);
+    assert_true(!PolyIsEq(&negated, &x0_plus_1));
+    PolyScaleInplace(&negated, -1);
+    assert_true(PolyIsEq(&negated, &x0_plus_1));
+
+    Poly product = PolyMul(&x0_plus_6, &x0_plus_1);
+    Poly x0_sq = MakeMonomial(1, 0, 2);
+    Poly expect = PolyAdd(&x0_sq, &six);
+    assert_true(PolyIsEq(&product, &expect));
+    assert_int_equal(PolyDeg(&product), 2);
+
+    Poly at = PolyAt(&product, -2);
+    assert_true(PolyIsCoeff(&at) && at.asCoef == 3);
+
+    Poly big = PolyFromCoeff(-15);
+    Poly reduced = PolyReduce(&big);
+    assert_true(PolyIsCoeff(&reduced) && reduced.asCoef == 6);
+    PolyScaleInplace(&product, 14);
+    assert_true(PolyIsZero(&product));
+
+    PolySetModulus(0);
+    PolyDestroy(&x0_plus_6);
+    PolyDestroy(&x0_plus_1);
+    PolyDestroy(&negated);
+    PolyDestroy(&product);
+    PolyDestroy(&x0_sq);
+    PolyDestroy(&expect);
+}
+
+
+/**
+ * \f$ (1 + x_0)^p = 1 + x_0^p \f$ modulo \f$ p \f$.
+ */
+static void TestPolyModularPow(void **state)
+{
+    (void)state;
+    const poly_coeff_t modulus = 1009;
+    PolySetModulus(modulus);
+
+    Poly one = PolyFromCoeff(1);
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly base = PolyAdd(&one, &x0);
+    Poly power = PolyPow(&base, (poly_exp_t)modulus);
+    Poly x0_p = MakeMonomial(1, 0, (poly_exp_t)modulus);
+    Poly expect = PolyAdd(&one, &x0_p);
+    assert_true(PolyIsEq(&power, &expect));
+
+    Poly shifted = PolyShift(&x0_p, 1);
+    assert_true(PolyIsEq(&shifted, &expect));
+
+    PolySetModulus(0);
+    PolyDestroy(&x0);
+    PolyDestroy(&base);
+    PolyDestroy(&power);
+    PolyDestroy(&x0_p);
+    PolyDestroy(&expect);
+    PolyDestroy(&shifted);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_exact
+/**
+ * Przepełniony współczynnik przechodzi na reprezentację wielokrotnej precyzji i wraca do zwykłej, gdy się zmieści.
+ */
+static void TestPolyExactSpill(void **state)
+{
+    (void)state;
+    PolySetExactCoefficients(true);
+
+    Poly max = PolyFromCoeff(POLY_COEFF_MAX);
+    Poly one = PolyFromCoeff(1);
+    Poly big = PolyAdd(&max, &one);
+    assert_true(PolyIsCoeff(&big) && !PolyIsZero(&big));
+    assert_false(PolyIsEq(&big, &max));
+    Poly big_clone = PolyClone(&big);
+    assert_true(PolyIsEq(&big, &big_clone));
+    assert_true(PolyHash(&big) == PolyHash(&big_clone));
+
+    Poly back = PolySub(&big, &one);
+    assert_true(PolyIsEq(&back, &max) && PolyIsSmallCoeff(&back) && back.asCoef == POLY_COEFF_MAX);
+
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly big_x0 = PolyMul(&x0, &big);
+    Poly square = PolyMul(&big_x0, &big_x0);
+    Poly other = PolyMul(&big, &big_x0);
+    Poly quotient_check = PolyMul(&other, &x0);
+    assert_true(PolyIsEq(&square, &quotient_check));
+    assert_false(PolyIsEq(&square, &other));
+
+    PolySetExactCoefficients(false);
+    Poly wrapped = PolyReduce(&big);
+    assert_true(PolyIsCoeff(&wrapped) && wrapped.asCoef == POLY_COEFF_MIN);
+
+    PolyDestroy(&big);
+    PolyDestroy(&big_clone);
+    PolyDestroy(&x0);
+    PolyDestroy(&big_x0);
+    PolyDestroy(&square);
+    PolyDestroy(&other);
+    PolyDestroy(&quotient_check);
+}
+
+
+/**
+ * Negacja i potęgowanie najmniejszej wartości <c>poly_coeff_t</c>.
+ */
+static void TestPolyExactNegMin(void **state)
+{
+    (void)state;
+    PolySetExactCoefficients(true);
+
+    Poly min = PolyFromCoeff(POLY_COEFF_MIN);
+    Poly negated = PolyNeg(&min);
+    Poly sum = PolyAdd(&negated, &min);
+    assert_true(PolyIsZero(&sum));
+    Poly twice = PolyNeg(&negated);
+    assert_true(PolyIsEq(&twice, &min) && PolyIsSmallCoeff(&twice));
+
+    Poly two = PolyFromCoeff(2);
+    Poly power = PolyPow(&two, POLY_COEFF_BITS);
+    Poly min_squared = PolyMul(&min, &min);
+    Poly four = PolyFromCoeff(4);
+    Poly expect = PolyMul(&min_squared, &four);
+    Poly power_128 = PolyPow(&power, 2);
+    assert_true(PolyIsEq(&power_128, &expect));
+
+    PolySetExactCoefficients(false);
+    PolyDestroy(&negated);
+    PolyDestroy(&power);
+    PolyDestroy(&min_squared);
+    PolyDestroy(&expect);
+    PolyDestroy(&power_128);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_mul_leaves
+/**
+ * Iloczyn liści (gęsty i rzadki, ze skracającymi się wyrazami) porównany z sumą iloczynów par jednomianów.
+ */
+static void TestPolyMulLeavesReference(void **state)
+{
+    (void)state;
+
+    const poly_exp_t length = 60;
+    const poly_coeff_t big = (poly_coeff_t)1 << (POLY_COEFF_BITS * 5 / 8);
+    const poly_exp_t steps[] = {1, 1000};
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); ++s) {
+        Mono p_monos[60], q_monos[60], products[60 * 60];
+        for (poly_exp_t i = 0; i < length; ++i) {
+            Poly p_coef = PolyFromCoeff((i * 37) % 11 - 5 ? (i * 37) % 11 - 5 : 1);
+            Poly q_coef = PolyFromCoeff(i % 2 == 0 ? big : -big);
+            p_monos[i] = MonoFromPoly(&p_coef, i * steps[s]);
+            q_monos[i] = MonoFromPoly(&q_coef, i * steps[s]);
+        }
+        for (poly_exp_t i = 0; i < length; ++i) {
+            for (poly_exp_t j = 0; j < length; ++j) {
+                Poly coef = PolyFromCoeff(p_monos[i].p.asCoef * q_monos[j].p.asCoef);
+                products[i * length + j] = MonoFromPoly(&coef, p_monos[i].exp + q_monos[j].exp);
+            }
+        }
+        Poly p = PolyAddMonos(length, p_monos);
+        Poly q = PolyAddMonos(length, q_monos);
+        Poly expect = PolyAddMonos(length * length, products);
+
+        Poly product = PolyMul(&p, &q);
+        assert_true(PolyIsEq(&product, &expect));
+
+        PolyDestroy(&p);
+        PolyDestroy(&q);
+        PolyDestroy(&expect);
+        PolyDestroy(&product);
+    }
+}
+
+
+/**
+ * W trybie dokładnym suma iloczynów liści może przekroczyć zakres akumulatora 128-bitowego.
+ */
+static void TestPolyMulLeavesExactOverflow(void **state)
+{
+    (void)state;
+    PolySetExactCoefficients(true);
+
+    Poly min = PolyFromCoeff(POLY_COEFF_MIN);
+    Poly min_x0 = MakeMonomial(POLY_COEFF_MIN, 0, 1);
+    Poly p = PolyAdd(&min_x0, &min);
+    Poly square = PolyMul(&p, &p);
+
+    Poly min_squared = PolyMul(&min, &min);
+    Poly twice = PolyAdd(&min_squared, &min_squared);
+    assert_int_equal(square.length, 3);
+    assert_true(PolyIsEq(&square.monos[0].p, &min_squared));
+    assert_true(PolyIsEq(&square.monos[1].p, &twice));
+    assert_true(PolyIsEq(&square.monos[2].p, &min_squared));
+
+    PolySetExactCoefficients(false);
+    PolyDestroy(&min_x0);
+    PolyDestroy(&p);
+    PolyDestroy(&square);
+    PolyDestroy(&min_squared);
+    PolyDestroy(&twice);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_dense
+/**
+ * Tworzy liść \f$ a + b x^e \f$ zależny od indeksu, używany jako współczynnik w testach gęstego mnożenia poziomu.
+ * @param i indeks
+ * @return liść
+ */
+static Poly MakeDenseChild(poly_exp_t i)
+{
+    Poly a = PolyFromCoeff(i % 5 - 2 ? i % 5 - 2 : 7);
+    Poly b = PolyFromCoeff(i + 1);
+    Mono monos[] = {MonoFromPoly(&a, 0), MonoFromPoly(&b, i % 3 + 1)};
+    return PolyAddMonos(2, monos);
+}
+
+
+/**
+ * Iloczyn wielomianów wielu zmiennych o gęstym i rzadkim najwyższym poziomie porównany z sumą iloczynów par
+ * jednomianów.
+ */
+static void TestPolyMulDenseLevel(void **state)
+{
+    (void)state;
+
+    const poly_exp_t length = 12;
+    const poly_exp_t steps[] = {1, 1000};
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); ++s) {
+        Mono p_monos[12], q_monos[12], products[12 * 12];
+        for (poly_exp_t i = 0; i < length; ++i) {
+            Poly p_coef = MakeDenseChild(i);
+            Poly q_coef = MakeDenseChild(length - i);
+            p_monos[i] = MonoFromPoly(&p_coef, i * steps[s]);
+            q_monos[i] = MonoFromPoly(&q_coef, 2 * i * steps[s]);
+        }
+        for (poly_exp_t i = 0; i < length; ++i) {
+            for (poly_exp_t j = 0; j < length; ++j) {
+                Poly coef = PolyMul(&p_monos[i].p, &q_monos[j].p);
+                products[i * length + j] = MonoFromPoly(&coef, p_monos[i].exp + q_monos[j].exp);
+            }
+        }
+        Poly p = PolyAddMonos(length, p_monos);
+        Poly q = PolyAddMonos(length, q_monos);
+        Poly expect = PolyAddMonos(length * length, products);
+
+        Poly product = PolyMul(&p, &q);
+        assert_true(PolyIsEq(&product, &expect));
+
+        PolyDestroy(&p);
+        PolyDestroy(&q);
+        PolyDestroy(&expect);
+        PolyDestroy(&product);
+    }
+}
+
+
+/**
+ * Wartość liścia z lukami między wykładnikami wyliczona schematem Hornera.
+ */
+static void TestPolyAtLeaf(void **state)
+{
+    (void)state;
+
+    Poly c0 = PolyFromCoeff(3), c2 = PolyFromCoeff(2), c5 = PolyFromCoeff(-1), c1001 = PolyFromCoeff(4);
+    Mono monos[] = {MonoFromPoly(&c0, 0), MonoFromPoly(&c2, 2), MonoFromPoly(&c5, 5), MonoFromPoly(&c1001, 1001)};
+    Poly p = PolyAddMonos(4, monos);
+
+    Poly at_zero = PolyAt(&p, 0);
+    Poly at_one = PolyAt(&p, 1);
+    Poly at_minus_one = PolyAt(&p, -1);
+    assert_true(PolyIsCoeff(&at_zero) && at_zero.asCoef == 3);
+    assert_true(PolyIsCoeff(&at_one) && at_one.asCoef == 8);
+    assert_true(PolyIsCoeff(&at_minus_one) && at_minus_one.asCoef == 2);
+
+    Poly x = MakeMonomial(1, 0, 1);
+    Poly square = PolyMul(&x, &x);
+    Poly shifted = PolyAdd(&square, &x);
+    Poly at_three = PolyAt(&shifted, 3);
+    assert_true(PolyIsCoeff(&at_three) && at_three.asCoef == 12);
+
+    PolyDestroy(&p);
+    PolyDestroy(&x);
+    PolyDestroy(&square);
+    PolyDestroy(&shifted);
+}
+
+
+/**
+ * Dodawanie, mnożenie przez skalar i porównywanie liści (także ze znoszącymi się wyrazami) porównane z wynikami
+ * wyliczonymi przez PolyAddMonos().
+ */
+static void TestPolyLeafKernels(void **state)
+{
+    (void)state;
+
+    const poly_exp_t length = 40;
+    Mono p_monos[40], q_monos[40], sum_monos[80], triple_monos[40];
+    //Co drugi jednomian q znosi jednomian p o tym samym wykładniku
+    for (poly_exp_t i = 0; i < length; ++i) {
+        poly_coeff_t c = i % 7 - 3 ? i % 7 - 3 : 5, c_twice = (2 * i) % 7 - 3 ? (2 * i) % 7 - 3 : 5;
+        Poly p_coef = PolyFromCoeff(c), triple = PolyFromCoeff(3 * c);
+        Poly q_coef = PolyFromCoeff(i % 2 == 0 && 2 * i < length ? -c_twice : 1);
+        p_monos[i] = MonoFromPoly(&p_coef, i);
+        q_monos[i] = MonoFromPoly(&q_coef, 2 * i);
+        triple_monos[i] = MonoFromPoly(&triple, i);
+        sum_monos[i] = p_monos[i];
+        sum_monos[length + i] = q_monos[i];
+    }
+    Poly p = PolyAddMonos(length, p_monos);
+    Poly q = PolyAddMonos(length, q_monos);
+    Poly expect_sum = PolyAddMonos(2 * length, sum_monos);
+    Poly expect_triple = PolyAddMonos(length, triple_monos);
+
+    Poly sum = PolyAdd(&p, &q);
+    assert_true(PolyIsEq(&sum, &expect_sum));
+    assert_true(PolyIsEq(&expect_sum, &sum));
+    assert_false(PolyIsEq(&sum, &p));
+
+    Poly negated = PolyClone(&p);
+    PolyScaleInplace(&negated, -1);
+    Poly zero = PolyAdd(&p, &negated);
+    assert_true(PolyIsZero(&zero));
+
+    Poly triple = PolyClone(&p);
+    PolyScaleInplace(&triple, 3);
+    assert_true(PolyIsEq(&triple, &expect_triple));
+    assert_false(PolyIsEq(&triple, &p));
+
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&expect_sum);
+    PolyDestroy(&expect_triple);
+    PolyDestroy(&sum);
+    PolyDestroy(&negated);
+    PolyDestroy(&zero);
+    PolyDestroy(&triple);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_shared
+/**
+ * Kopia współdzieli tablicę jednomianów z oryginałem, a zmiana kopii w miejscu nie zmienia oryginału.
+ */
+static void TestPolyCloneShared(void **state)
+{
+    (void)state;
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(2, 1, 1);
+    Poly sum = PolyAdd(&x0, &x1);
+    Poly p = PolyPow(&sum, 3);
+    Poly expect = PolyPow(&sum, 3);
+
+    Poly clone = PolyClone(&p);
+    assert_true(clone.monos == p.monos);
+    PolyScaleInplace(&clone, -1);
+    assert_true(clone.monos != p.monos);
+    assert_true(PolyIsEq(&p, &expect));
+
+    Poly negated = PolyNeg(&p);
+    assert_true(PolyIsEq(&clone, &negated));
+
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+    PolyDestroy(&sum);
+    PolyDestroy(&p);
+    PolyDestroy(&expect);
+    PolyDestroy(&clone);
+    PolyDestroy(&negated);
+}
+
+
+/**
+ * Jednomiany o małym współczynniku i wykładniku dzielą jedną, statyczną tablicę, której zmiana kopii w miejscu nie
+ * dotyka; większe jednomiany dostają własne tablice.
+ */
+static void TestPolySmallTermShared(void **state)
+{
+    (void)state;
+    Poly a = MakeMonomial(3, 0, 2);
+    Poly b = MakeMonomial(3, 0, 2);
+    Poly large = MakeMonomial(100, 0, 2);
+    Poly large_again = MakeMonomial(100, 0, 2);
+    Poly nested = MakeMonomial(3, 1, 2);
+    assert_true(a.monos == b.monos);
+    assert_true(large.monos != large_again.monos);
+    assert_true(nested.monos[0].p.monos == a.monos);
+
+    Poly scaled = PolyClone(&a);
+    PolyScaleInplace(&scaled, 2);
+    Poly six = MakeMonomial(6, 0, 2);
+    assert_true(scaled.monos != a.monos);
+    assert_true(PolyIsEq(&scaled, &six));
+    assert_true(PolyIsEq(&a, &b) && a.monos[0].p.asCoef == 3);
+
+    Poly interned = PolyIntern(&a);
+    assert_true(PolyIsEq(&interned, &a));
+
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&large);
+    PolyDestroy(&large_again);
+    PolyDestroy(&nested);
+    PolyDestroy(&scaled);
+    PolyDestroy(&six);
+    PolyDestroy(&interned);
+}
+
+
+#ifdef POLY_COMPACT_MONO
+//**********************************************************************************************************************
+// unit_tests/poly_compact
+/**
+ * W zwartym układzie jednomian zajmuje 16 bajtów, a współczynnik (także skrajne wartości i zero) jest rozpoznawany po
+ * zerowej długości, niezależnie od bitów dzielonych ze wskaźnikiem na jednomiany.
+ */
+static void TestPolyCompactMono(void **state)
+{
+    (void)state;
+    assert_int_equal(sizeof(Mono), 16);
+
+    const poly_coeff_t coeffs[] = {0, 1, -1, POLY_COEFF_MIN, POLY_COEFF_MAX};
+    for (size_t i = 0; i < sizeof(coeffs) / sizeof(coeffs[0]); ++i) {
+        Poly c = PolyFromCoeff(coeffs[i]);
+        assert_true(PolyIsCoeff(&c) && PolyIsSmallCoeff(&c) && c.asCoef == coeffs[i]);
+        assert_true(PolyIsZero(&c) == (coeffs[i] == 0));
+
+        Poly m = MakeMonomial(coeffs[i], 1, 3);
+        assert_true(PolyIsZero(&m) == (coeffs[i] == 0));
+        if (coeffs[i] != 0) {
+            assert_false(PolyIsCoeff(&m));
+            assert_int_equal(m.length, 1);
+            assert_true(m.monos[0].p.length == 1 && m.monos[0].p.monos[0].p.asCoef == coeffs[i]);
+        }
+        PolyDestroy(&m);
+    }
+
+    PolySetExactCoefficients(true);
+    Poly max = PolyFromCoeff(POLY_COEFF_MAX);
+    Poly one = PolyFromCoeff(1);
+    Poly big = PolyAdd(&max, &one);
+    assert_true(PolyIsCoeff(&big) && !PolyIsSmallCoeff(&big));
+    Poly back = PolySub(&big, &one);
+    assert_true(PolyIsSmallCoeff(&back) && back.asCoef == POLY_COEFF_MAX);
+    PolySetExactCoefficients(false);
+    PolyDestroy(&big);
+}
+#endif
+
+
+#ifdef POLY_UNIT_TESTING_POOL
+//**********************************************************************************************************************
+// unit_tests/poly_pool
+
+///Liczba jednomianów wielomianów w testach puli; ich tablice mają własną klasę rozmiaru
+#define POOL_TEST_LENGTH 7
+
+///Ile wielomianów najwyżej tworzy test, zanim dojdzie do tablic oddanych przez zakończony wątek
+#define POOL_TEST_MAX_POLYS 20000
+
+
+/**
+ * Tworzy wielomian \f$ \sum_{i < \text{POOL_TEST_LENGTH}} (i + 1) x_0^i \f$ z jedną tablicą jednomianów.
+ * @return wielomian
+ */
+static Poly MakePoolSample(void)
+{
+    Mono monos[POOL_TEST_LENGTH];
+    for (poly_exp_t i = 0; i < POOL_TEST_LENGTH; ++i) {
+        Poly coef = PolyFromCoeff(i + 1);
+        monos[i] = MonoFromPoly(&coef, i);
+    }
+    return PolyAddMonos(POOL_TEST_LENGTH, monos);
+}
+
+
+/**
+ * Zwolniona tablica trafia na listę wolnych tablic wątku i jest używana przez następny wielomian tej samej długości.
+ */
+static void TestPolyPoolReuse(void **state)
+{
+    (void)state;
+    Poly p = MakePoolSample();
+    const Mono *monos = p.monos;
+    PolyDestroy(&p);
+
+    Poly q = MakePoolSample();
+    assert_true(q.monos == monos);
+    Poly expect = MakePoolSample();
+    assert_true(PolyIsEq(&q, &expect));
+
+    PolyDestroy(&q);
+    PolyDestroy(&expect);
+}
+
+
+/**
+ * Wątek tworzący i usuwający wielomian.
+ * @param arg miejsce na adres tablicy jednomianów wielomianu
+ * @return <c>NULL</c>
+ */
+static void *PoolThread(void *arg)
+{
+    Poly p = MakePoolSample();
+    *(const Mono **)arg = p.monos;
+    PolyDestroy(&p);
+    return NULL;
+}
+
+
+/**
+ * Wolne tablice wątku użytkownika nie przepadają, gdy wątek się kończy: po wyczerpaniu własnych wolnych tablic
+ * główny wątek dostaje tablicę zwolnioną przez zakończony wątek.
+ */
+static void TestPolyPoolThreadExit(void **state)
+{
+    (void)state;
+    const Mono *released = NULL;
+    pthread_t thread;
+    assert_int_equal(pthread_create(&thread, NULL, PoolThread, &released), 0);
+    pthread_join(thread, NULL);
+
+    Poly *polys = malloc(sizeof(Poly) * POOL_TEST_MAX_POLYS);
+    assert_true(polys != NULL);
+    size_t count = 0;
+    bool found = false;
+    while (!found && count < POOL_TEST_MAX_POLYS) {
+        polys[count] = MakePoolSample();
+        found = polys[count++].monos == released;
+    }
+    assert_true(found);
+
+    for (size_t i = 0; i < count; ++i)
+        PolyDestroy(polys + i);
+    free(polys);
+}
+#endif
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_arena
+/**
+ * Zakres areny nie zmienia wyników. W podstawowym wariancie testów z CMocka tablice pochodzą z malloc, więc arena
+ * działa tylko w wariancie z <c>POLY_UNIT_TESTING_POOL</c>; wydzielanie tablic z areny i przenoszenie wyniku
+ * dokładnie sprawdza internal_tests_poly.
+ */
+static void TestPolyArenaPromote(void **state)
+{
+    (void)state;
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(2, 1, 1);
+    Poly p = PolyAdd(&x0, &x1);
+
+    PolyArenaBegin();
+    Poly square = PolyMul(&p, &p);
+    Poly result = PolyPow(&square, 3);
+    PolyDestroy(&square);
+    PolyArenaEnd(&result);
+
+    PolyArenaBegin();
+    Poly other = PolyPow(&p, 7);
+    PolyDestroy(&other);
+    PolyArenaEnd(NULL);
+
+    Poly expect = PolyPow(&p, 6);
+    assert_true(PolyIsEq(&result, &expect));
+
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+    PolyDestroy(&p);
+    PolyDestroy(&result);
+    PolyDestroy(&expect);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_intern
+/**
+ * Równe wielomiany zbudowane na różne sposoby dostają tę samą tablicę, a różne są rozróżniane bez porównywania
+ * zawartości.
+ */
+static void TestPolyIntern(void **state)
+{
+    (void)state;
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(2, 1, 1);
+    Poly sum = PolyAdd(&x0, &x1);
+    Poly square = PolyMul(&sum, &sum);
+    Poly sum_of_squares = PolyAdd(&square, &square);
+    Poly twice = PolyClone(&square);
+    PolyScaleInplace(&twice, 2);
+
+    Poly a = PolyIntern(&sum_of_squares);
+    Poly b = PolyIntern(&twice);
+    Poly c = PolyIntern(&square);
+    assert_true(a.monos == b.monos);
+    assert_true(a.monos != c.monos);
+    assert_true(PolyIsEq(&a, &b));
+    assert_false(PolyIsEq(&a, &c));
+
+    Poly again = PolyIntern(&a);
+    assert_true(again.monos == a.monos);
+
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&c);
+    PolyDestroy(&again);
+
+    Poly d = PolyIntern(&twice);
+    assert_true(PolyIsEq(&d, &sum_of_squares));
+
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+    PolyDestroy(&sum);
+    PolyDestroy(&square);
+    PolyDestroy(&sum_of_squares);
+    PolyDestroy(&twice);
+    PolyDestroy(&d);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_cache
+/**
+ * Wyniki działań na internowanych wielomianach są zapamiętywane (także dla argumentów w odwrotnej kolejności), a
+ * ominięcie pamięci podręcznej i zerowy budżet dają te same wyniki bez niej.
+ */
+static void TestPolyCache(void **state)
+{
+    (void)state;
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(2, 1, 1);
+    Poly sum = PolyAdd(&x0, &x1);
+    Poly cube = PolyPow(&sum, 3);
+    Poly fourth = PolyPow(&sum, 4);
+    Poly a = PolyIntern(&cube);
+    Poly b = PolyIntern(&fourth);
+
+    Poly product = PolyMul(&a, &b);
+    PolyCacheStats before = PolyGetCacheStats();
+    Poly swapped = PolyMul(&b, &a);
+    PolyCacheStats after = PolyGetCacheStats();
+    assert_true(swapped.monos == product.monos);
+    assert_int_equal(after.hits, before.hits + 1);
+    assert_true(after.entries > 0);
+
+    bool bypass = PolySetCacheBypass(true);
+    Poly uncached = PolyMul(&a, &b);
+    assert_true(uncached.monos != product.monos);
+    assert_true(PolyIsEqProbable(&uncached, &product, 4));
+    PolySetCacheBypass(bypass);
+
+    Poly power = PolyPow(&a, 2);
+    Poly power_again = PolyPow(&a, 2);
+    assert_true(power.monos == power_again.monos);
+
+    PolySetCacheBudget(0);
+    assert_int_equal(PolyGetCacheStats().entries, 0);
+    Poly power_uncached = PolyPow(&a, 2);
+    assert_true(power_uncached.monos != power.monos);
+    assert_true(PolyIsEqProbable(&power_uncached, &power, 4));
+    PolySetCacheBudget((size_t)64 << 20);
+
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+    PolyDestroy(&sum);
+    PolyDestroy(&cube);
+    PolyDestroy(&fourth);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&product);
+    PolyDestroy(&swapped);
+    PolyDestroy(&uncached);
+    PolyDestroy(&power);
+    PolyDestroy(&power_again);
+    PolyDestroy(&power_uncached);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_frozen
+/**
+ * Zamrożenie i rozmrożenie zachowuje wielomian, a operacje na postaci zamrożonej zgadzają się z operacjami na
+ * zwykłej.
+ */
+static void TestPolyFreeze(void **state)
+{
+    (void)state;
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly x1 = MakeMonomial(2, 1, 3);
+    Poly sum = PolyAdd(&x0, &x1);
+    Poly cube = PolyPow(&sum, 3);
+    Poly nested_coeff = MakeMonomial(5, 2, 0);
+
+    PolyFrozen frozen, frozen_again, coeff;
+    assert_true(PolyFreeze(&cube, &frozen));
+    assert_true(PolyFreeze(&cube, &frozen_again));
+    assert_true(PolyFreeze(&nested_coeff, &coeff));
+    assert_false(PolyFrozenIsCoeff(&frozen));
+    assert_true(PolyFrozenIsCoeff(&coeff));
+    assert_int_equal(coeff.coef, 5);
+
+    Poly thawed = PolyThaw(&frozen);
+    assert_true(PolyIsEq(&thawed, &cube));
+    assert_true(PolyFrozenIsEq(&frozen, &frozen_again));
+    assert_int_equal(PolyFrozenHash(&frozen), PolyHash(&cube));
+    assert_int_equal(PolyFrozenHash(&coeff), PolyHash(&nested_coeff));
+    assert_int_equal(PolyFrozenDeg(&frozen), PolyDeg(&cube));
+    for (unsigned var = 0; var < 3; ++var)
+        assert_int_equal(PolyFrozenDegBy(&frozen, var), PolyDegBy(&cube, var));
+
+    PolyFrozen copy = PolyFrozenClone(&frozen);
+    PolyFrozenDestroy(&frozen);
+    assert_true(PolyFrozenIsEq(&copy, &frozen_again));
+    PolyFrozen other;
+    assert_true(PolyFreeze(&sum, &other));
+    assert_false(PolyFrozenIsEq(&copy, &other));
+
+    PolyDestroy(&x0);
+    PolyDestroy(&x1);
+    PolyDestroy(&sum);
+    PolyDestroy(&cube);
+    PolyDestroy(&nested_coeff);
+    PolyDestroy(&thawed);
+    PolyFrozenDestroy(&frozen_again);
+    PolyFrozenDestroy(&coeff);
+    PolyFrozenDestroy(&copy);
+    PolyFrozenDestroy(&other);
+}
+
+
+//**********************************************************************************************************************
+// unit_tests/poly_checked
+/**
+ * Iloczyn, który mieści się w <c>poly_coeff_t</c> mimo dużych czynników, i iloczyn, który się nie mieści.
+ */
+static void TestPolyMulChecked(void **state)
+{
+    (void)state;
+    const poly_coeff_t big = (poly_coeff_t)1 << (POLY_COEFF_BITS - 2);
+
+    Poly x0 = MakeMonomial(1, 0, 1);
+    Poly one = PolyFromCoeff(1);
+    Poly big_x0 = MakeMonomial(big, 0, 1);
+    Poly big_coeff = PolyFromCoeff(big);
+    Poly p = PolyAdd(&big_x0, &big_coeff);
+    Poly q = PolySub(&x0, &one);
+
+    Poly checked;
+    assert_true(PolyMulChecked(&p, &q, &checked));
+    Poly expect = PolyMul(&p, &q);
+    assert_true(PolyIsEq(&checked, &expect));
+
+    Poly untouched = PolyFromCoeff(7);
+    assert_false(PolyMulChecked(&p, &p, &untouched));
+    assert_true(PolyIsCoeff(&untouched) && untouched.asCoef == 7);
+
+    PolyDestroy(&x0);
+    PolyDestroy(&big_x0);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&checked);
+    PolyDestroy(&expect);
+}
+
+
+/**
+ * Złożenie \f$ x_0^2 \f$ z \f$ 2^{31} \f$ mieści się w 64-bitowym <c>poly_coeff_t</c>, a z \f$ 2^{32} \f$ już nie
+ * (w 32-bitowym odpowiednio \f$ 2^{15} \f$ i \f$ 2^{16} \f$).
+ */
+static void TestPolyComposeChecked(void **state)
+{
+    (void)state;
+
+    Poly x0_sq = MakeMonomial(1, 0, 2);
+    Poly fits = PolyFromCoeff((poly_coeff_t)1 << (POLY_COEFF_BITS / 2 - 1));
+    Poly overflows = PolyFromCoeff((poly_coeff_t)1 << (POLY_COEFF_BITS / 2));
+
+    Poly result;
+    assert_true(PolyComposeChecked(&x0_sq, 1, &fits, &result));
+    assert_true(PolyIsCoeff(&result) && result.asCoef == (poly_coeff_t)1 << (POLY_COEFF_BITS - 2));
+    assert_false(PolyComposeChecked(&x0_sq, 1, &overflows, &result));
+
+    PolySetModulus(7);
+    Poly fits_reduced = PolyReduce(&fits);
+    assert_true(PolyComposeChecked(&x0_sq, 1, &fits_reduced, &result));
+    assert_true(PolyIsCoeff(&result) && result.asCoef == fits_reduced.asCoef * fits_reduced.asCoef % 7);
+    PolySetModulus(0);
+
+    PolyDestroy(&x0_sq);
+}
+
+
 //**********************************************************************************************************************
 // unit_tests/calc_compose
 /**
@@ -589,6 +1965,206 @@ static void TestCalcCompose44Capybaras(void **state)
 }
 
 
+/**
+ * <c>SHIFT</c> z poprawnym i niepoprawnymi parametrami.
+ */
+static void TestCalcShift(void **state)
+{
+    (void)state;
+    const char *in = "(1,2)+((1,1),1)\nSHIFT -1\nPRINT\nSHIFT\nSHIFT 1a\n";
+    const char *expected_out = "((1,0)+(-1,1),0)+((-2,0)+(1,1),1)+(1,2)\n";
+    const char *expected_err = "ERROR 4 WRONG VALUE\nERROR 5 WRONG VALUE\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * <c>POW</c> z poprawnym i niepoprawnymi parametrami.
+ */
+static void TestCalcPow(void **state)
+{
+    (void)state;
+    const char *in = "(1,0)+((-1,1),1)\nPOW 2\nPRINT\nPOW 0\nPRINT\nPOW\nPOW -1\nPOW 2147483648\n";
+    const char *expected_out = "(1,0)+((-2,1),1)+((1,2),2)\n1\n";
+    const char *expected_err = "ERROR 6 WRONG EXPONENT\nERROR 7 WRONG EXPONENT\nERROR 8 WRONG EXPONENT\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * <c>IS_EQ</c> po <c>CLONE</c> i <c>NEG</c> (zapamiętany skrót musi zostać unieważniony).
+ */
+static void TestCalcIsEqHash(void **state)
+{
+    (void)state;
+    const char *in = "(1,1)+(2,3)\nCLONE\nIS_EQ\nNEG\nIS_EQ\nNEG\nIS_EQ\n5\n(5,0)+(0,2)\nIS_EQ\n";
+    const char *expected_out = "1\n0\n1\n1\n";
+    const char *expected_err = "";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * <c>IS_EQ_FAST</c> dla równych i różnych wielomianów oraz przy zbyt małym stosie, także dla dużego współczynnika
+ * \f$ 2^{63} \f$ i małego \f$ -2^{63} \f$ o tych samych bitach.
+ */
+static void TestCalcIsEqFast(void **state)
+{
+    (void)state;
+    const char *in = "(1,1)+(2,3)\nIS_EQ_FAST\nCLONE\nIS_EQ_FAST\nNEG\nIS_EQ_FAST\nIS_EQ_FAST 1\n";
+    const char *expected_out = "1\n0\n";
+    const char *expected_err = "ERROR 2 STACK UNDERFLOW\nERROR 7 WRONG COMMAND\n";
+    TestCore(in, expected_out, expected_err);
+
+#if POLY_COEFF_BITS == 64
+    in = "EXACT 1\n9223372036854775807\n1\nADD\n-9223372036854775808\nIS_EQ_FAST\nIS_EQ\nNEG\nIS_EQ_FAST\nEXACT 0\n";
+#else
+    in = "EXACT 1\n2147483647\n1\nADD\n-2147483648\nIS_EQ_FAST\nIS_EQ\nNEG\nIS_EQ_FAST\nEXACT 0\n";
+#endif
+    TestCore(in, "0\n0\n1\n", "");
+}
+
+
+/**
+ * <c>MOD</c> redukuje stos i kolejne wielomiany; niepoprawne moduły są odrzucane.
+ */
+static void TestCalcMod(void **state)
+{
+    (void)state;
+    const char *in = "-1\nMOD 7\nPRINT\n(3,1)\nCLONE\nMUL\nPRINT\nMOD 4\nMOD\nMOD 0\n5\nNEG\nPRINT\n";
+    const char *expected_out = "6\n(2,2)\n-5\n";
+    const char *expected_err = "ERROR 8 WRONG MODULUS\nERROR 9 WRONG MODULUS\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Przy ustawionym module współczynniki wczytywanego wielomianu są redukowane przed zsumowaniem.
+ */
+static void TestCalcModParsedSum(void **state)
+{
+    (void)state;
+#if POLY_COEFF_BITS == 64
+    const char *in = "MOD 1000003\n(9223372036854775807,1)+(1,1)\nPRINT\n"
+                     "(9223372036854775807,1)+(9223372036854775807,1)\nPRINT\nMOD 0\n";
+    const char *expected_out = "(675345,1)\n(350685,1)\n";
+#else
+    const char *in = "MOD 1000003\n(2147483647,1)+(1,1)\nPRINT\n(2147483647,1)+(2147483647,1)\nPRINT\nMOD 0\n";
+    const char *expected_out = "(477207,1)\n(954412,1)\n";
+#endif
+    TestCore(in, expected_out, "");
+}
+
+
+/**
+ * Testy polecenia EXACT
+ */
+static void TestCalcExact(void **state)
+{
+    (void)state;
+#if POLY_COEFF_BITS == 64
+    const char *in = "EXACT 1\n9223372036854775807\n1\nADD\nPRINT\nCLONE\nMUL\nPRINT\nEXACT 0\nPRINT\nEXACT 2\n";
+    const char *expected_out = "9223372036854775808\n85070591730234615865843651857942052864\n0\n";
+#else
+    const char *in = "EXACT 1\n2147483647\n1\nADD\nPRINT\nCLONE\nMUL\nPRINT\nEXACT 0\nPRINT\nEXACT 2\n";
+    const char *expected_out = "2147483648\n4611686018427387904\n0\n";
+#endif
+    const char *expected_err = "ERROR 11 WRONG VALUE\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Testy polecenia CHECKED
+ */
+static void TestCalcChecked(void **state)
+{
+    (void)state;
+#if POLY_COEFF_BITS == 64
+    const char *in = "CHECKED 1\n4294967296\n(1,2)\nCOMPOSE 1\nPRINT\n(3037000499,1)\nCLONE\nMUL\nPRINT\nCLONE\nMUL\n"
+            "CHECKED 0\nPOP\nPOP\nMUL\nPRINT\nCHECKED 2\n";
+    const char *expected_out = "(1,2)\n(9223372030926249001,2)\n(4294967296,2)\n";
+#else
+    const char *in = "CHECKED 1\n65536\n(1,2)\nCOMPOSE 1\nPRINT\n(46340,1)\nCLONE\nMUL\nPRINT\nCLONE\nMUL\n"
+            "CHECKED 0\nPOP\nPOP\nMUL\nPRINT\nCHECKED 2\n";
+    const char *expected_out = "(1,2)\n(2147395600,2)\n(65536,2)\n";
+#endif
+    const char *expected_err = "ERROR 4 OVERFLOW\nERROR 11 OVERFLOW\nERROR 17 WRONG VALUE\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Testy polecenia INTERN
+ */
+static void TestCalcIntern(void **state)
+{
+    (void)state;
+    const char *in = "INTERN 1\n((1,1)+(2,0),1)+((1,1)+(2,0),3)\n((2,0)+(1,1),3)+((1,1)+(2,0),1)\nIS_EQ\nNEG\nIS_EQ\n"
+            "NEG\nIS_EQ\nADD\nPRINT\nINTERN 2\nINTERN 0\nCLONE\nIS_EQ\n";
+    const char *expected_out = "1\n0\n1\n((4,0)+(2,1),1)+((4,0)+(2,1),3)\n1\n";
+    const char *expected_err = "ERROR 11 WRONG VALUE\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Testy polecenia CACHE_CLEAR
+ */
+static void TestCalcCacheClear(void **state)
+{
+    (void)state;
+    const char *in = "INTERN 1\n(1,0)+(1,1)+(1,2)+(1,3)\nPOW 2\nCACHE_CLEAR\n(1,0)+(1,1)+(1,2)+(1,3)\nPOW 2\nIS_EQ\n"
+            "CACHE_CLEAR 1\nPRINT\n";
+    const char *expected_out = "1\n(1,0)+(2,1)+(3,2)+(4,3)+(3,4)+(2,5)+(1,6)\n";
+    const char *expected_err = "ERROR 8 WRONG COMMAND\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Testy FREEZE: operacje czytające działają na zamrożonych elementach, a arytmetyka je rozmraża
+ */
+static void TestCalcFreeze(void **state)
+{
+    (void)state;
+    const char *in = "FREEZE 1\n(1,0)+(1,1)\n((2,1),2)\nCLONE\nPOP\nADD\nCLONE\n(3,0)\nPOP\nPRINT\nDEG\nDEG_BY 1\n"
+            "IS_EQ\nCLONE\nMUL\nFREEZE 0\nPRINT\nFREEZE 2\n";
+    const char *expected_out = "(1,0)+(1,1)+((2,1),2)\n3\n1\n1\n(1,0)+(2,1)+((1,0)+(4,1),2)+((4,1),3)+((4,2),4)\n";
+    const char *expected_err = "ERROR 18 WRONG VALUE\n";
+    TestCore(in, expected_out, expected_err);
+}
+
+
+/**
+ * Opcja <c>--coeff-bits=</c>: szerokość, z którą skompilowano program, jest przyjmowana, a niepoprawne wywołanie
+ * kończy się kodem 1 bez czytania wejścia.
+ */
+static void TestCalcCoeffBitsOption(void **state)
+{
+    (void)state;
+    const char *usage = "Usage: ./calc_poly [--coeff-bits=64|--coeff-bits=32]\n";
+    char option[32];
+    sprintf(option, "--coeff-bits=%d", POLY_COEFF_BITS);
+
+    FeedInput(stdin, "(1,1)\nPRINT\n", strlen("(1,1)\nPRINT\n"));
+    ExpectOutput(stdout, "(1,1)\n");
+    ExpectOutput(stderr, "");
+    assert_int_equal(tested_main(2, (char*[]){"./calc_poly", option}), 0);
+    assert_true(CheckOutput(false));
+
+    char *invalid[][3] = {{"./calc_poly", "--coeff-bits=16"}, {"./calc_poly", "-x"},
+                          {"./calc_poly", option, option}};
+    for (int i = 0; i < 3; ++i) {
+        FeedInput(stdin, "", 0);
+        ExpectOutput(stdout, "");
+        ExpectOutput(stderr, usage);
+        assert_int_equal(tested_main(i < 2 ? 2 : 3, invalid[i]), 1);
+        assert_true(CheckOutput(false));
+    }
+}
+
+
 /**
  * Testy compose z przykładu
  */
@@ -789,9 +2365,118 @@ int main(int argc, char **argv)
             cmocka_unit_test(TestPolyComposeLinZero),
             cmocka_unit_test(TestPolyComposeLinConst),
             cmocka_unit_test(TestPolyComposeLinLin),
+            cmocka_unit_test(TestPolyComposeConstSubs),
+            cmocka_unit_test(TestPolyComposeMonomialSubs),
+            cmocka_unit_test(TestPolyComposePermutation),
+            cmocka_unit_test(TestPolyComposeDenseSubs),
+            cmocka_unit_test(TestPolyShiftSquare),
+            cmocka_unit_test(TestPolyShiftCompose),
+            cmocka_unit_test(TestPolyPowFewTerms),
+            cmocka_unit_test(TestPolyPowDense),
+            cmocka_unit_test(TestPolyPowMultivariate),
     };
     failed += cmocka_run_group_tests_name("PolyCompose tests", compose_tests, NULL, NULL);
 
+    //Testy PolyAddMonos
+    const struct CMUnitTest add_monos_tests[] = {
+            cmocka_unit_test(TestPolyAddMonosUnsorted),
+            cmocka_unit_test(TestPolyAddMonosRuns),
+    };
+    failed += cmocka_run_group_tests_name("PolyAddMonos tests", add_monos_tests, NULL, NULL);
+
+    //Testy PolyHash
+    const struct CMUnitTest hash_tests[] = {
+            cmocka_unit_test(TestPolyHashCanonical),
+            cmocka_unit_test(TestPolyHashDistinct),
+            cmocka_unit_test(TestPolyIsEqProbable),
+    };
+    failed += cmocka_run_group_tests_name("PolyHash tests", hash_tests, NULL, NULL);
+
+    //Testy arytmetyki modularnej
+    const struct CMUnitTest modular_tests[] = {
+            cmocka_unit_test(TestPolyModulusValid),
+            cmocka_unit_test(TestPolyModularArithmetic),
+            cmocka_unit_test(TestPolyModularPow),
+    };
+    failed += cmocka_run_group_tests_name("Modular arithmetic tests", modular_tests, NULL, NULL);
+
+    //Testy dokładnych współczynników
+    const struct CMUnitTest exact_tests[] = {
+            cmocka_unit_test(TestPolyExactSpill),
+            cmocka_unit_test(TestPolyExactNegMin),
+    };
+    failed += cmocka_run_group_tests_name("Exact coefficient tests", exact_tests, NULL, NULL);
+
+    //Testy mnożenia liści z akumulatorami 128-bitowymi
+    const struct CMUnitTest mul_leaves_tests[] = {
+            cmocka_unit_test(TestPolyMulLeavesReference),
+            cmocka_unit_test(TestPolyMulLeavesExactOverflow),
+    };
+    failed += cmocka_run_group_tests_name("Leaf multiplication tests", mul_leaves_tests, NULL, NULL);
+
+    //Testy gęstego mnożenia poziomów i jąder działań na liściach
+    const struct CMUnitTest dense_tests[] = {
+            cmocka_unit_test(TestPolyMulDenseLevel),
+            cmocka_unit_test(TestPolyAtLeaf),
+            cmocka_unit_test(TestPolyLeafKernels),
+    };
+    failed += cmocka_run_group_tests_name("Dense level and leaf kernel tests", dense_tests, NULL, NULL);
+
+    //Testy współdzielenia tablic jednomianów
+    const struct CMUnitTest shared_tests[] = {
+            cmocka_unit_test(TestPolyCloneShared),
+            cmocka_unit_test(TestPolySmallTermShared),
+    };
+    failed += cmocka_run_group_tests_name("Shared array tests", shared_tests, NULL, NULL);
+
+#ifdef POLY_COMPACT_MONO
+    //Testy zwartego układu jednomianu
+    const struct CMUnitTest compact_tests[] = {
+            cmocka_unit_test(TestPolyCompactMono),
+    };
+    failed += cmocka_run_group_tests_name("Compact mono tests", compact_tests, NULL, NULL);
+#endif
+
+#ifdef POLY_UNIT_TESTING_POOL
+    //Testy puli tablic jednomianów
+    const struct CMUnitTest pool_tests[] = {
+            cmocka_unit_test(TestPolyPoolReuse),
+            cmocka_unit_test(TestPolyPoolThreadExit),
+    };
+    failed += cmocka_run_group_tests_name("Pool tests", pool_tests, NULL, NULL);
+#endif
+
+    //Testy areny
+    const struct CMUnitTest arena_tests[] = {
+            cmocka_unit_test(TestPolyArenaPromote),
+    };
+    failed += cmocka_run_group_tests_name("Arena tests", arena_tests, NULL, NULL);
+
+    //Testy internowania tablic jednomianów
+    const struct CMUnitTest intern_tests[] = {
+            cmocka_unit_test(TestPolyIntern),
+    };
+    failed += cmocka_run_group_tests_name("Interning tests", intern_tests, NULL, NULL);
+
+    //Testy pamięci podręcznej działań
+    const struct CMUnitTest cache_tests[] = {
+            cmocka_unit_test(TestPolyCache),
+    };
+    failed += cmocka_run_group_tests_name("Operation cache tests", cache_tests, NULL, NULL);
+
+    //Testy postaci zamrożonej
+    const struct CMUnitTest frozen_tests[] = {
+            cmocka_unit_test(TestPolyFreeze),
+    };
+    failed += cmocka_run_group_tests_name("Frozen polynomial tests", frozen_tests, NULL, NULL);
+
+    //Testy mnożenia i składania z wykrywaniem przepełnień
+    const struct CMUnitTest checked_tests[] = {
+            cmocka_unit_test(TestPolyMulChecked),
+            cmocka_unit_test(TestPolyComposeChecked),
+    };
+    failed += cmocka_run_group_tests_name("Checked arithmetic tests", checked_tests, NULL, NULL);
+
     //Testy programu
     const struct CMUnitTest program_tests[] = {
             cmocka_unit_test(TestCalcComposeNoParam),
@@ -802,6 +2487,18 @@ int main(int argc, char **argv)
             cmocka_unit_test(TestCalcComposeOooveeerflooow),
             cmocka_unit_test(TestCalcComposeCapybara),
             cmocka_unit_test(TestCalcCompose44Capybaras),
+            cmocka_unit_test(TestCalcShift),
+            cmocka_unit_test(TestCalcPow),
+            cmocka_unit_test(TestCalcIsEqHash),
+            cmocka_unit_test(TestCalcIsEqFast),
+            cmocka_unit_test(TestCalcMod),
+            cmocka_unit_test(TestCalcModParsedSum),
+            cmocka_unit_test(TestCalcExact),
+            cmocka_unit_test(TestCalcChecked),
+            cmocka_unit_test(TestCalcIntern),
+            cmocka_unit_test(TestCalcCacheClear),
+            cmocka_unit_test(TestCalcFreeze),
+            cmocka_unit_test(TestCalcCoeffBitsOption),
 //            cmocka_unit_test(TestCalcComposeExample),
     };
     failed += cmocka_run_group_tests_name("Program tests", program_tests, NULL, NULL);